@@ -0,0 +1,323 @@
+#include "bvh_PatchTree.h"
+#include "exceptions.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+namespace
+{
+    // A sub-patch is flat when its poles are closer to the bilinear patch of its corners
+    // than this ratio of the diagonal of its box.
+    constexpr double Flatness = 0.05;
+
+    // Number of bins of the centroids along each axis.
+    constexpr int NbBins = 16;
+
+    // Cost of the traversal of an inner node, relative to the intersection of an element.
+    constexpr double TraversalCost = 0.125;
+
+    // Smallest number of elements of a subtree built on its own thread.
+    constexpr int MinParallelSize = 1 << 12;
+
+    // Number of patches in a chunk of the parallel refinement.
+    constexpr int Grain = 16;
+
+    // Net of the homogeneous poles of a sub-patch, the pole (i, j) at the index i * nbV + j.
+    struct Net
+    {
+        int nbU, nbV;
+        gp_Array1OfPnt4d poles;
+        double u1, u2, v1, v2;
+        int splitsU, splitsV;
+    };
+
+    // Splits the net at the middle of u (along = true) or v with the de Casteljau algorithm on its columns or rows.
+    void Split(const Net& net, const bool alongU, Net& low, Net& high)
+    {
+        low = net;
+        high = net;
+        const int nbCurves = alongU ? net.nbV : net.nbU;
+        const int degree = (alongU ? net.nbU : net.nbV) - 1;
+        gp_Pnt4d q[Geom_BezierKernel::MaxNbPoles];
+        for (int c = 0; c < nbCurves; ++c)
+        {
+            auto index = [&](const int k)
+            {
+                return alongU ? k * net.nbV + c : c * net.nbV + k;
+            };
+            for (int k = 0; k <= degree; ++k)
+            {
+                q[k] = net.poles[index(k)];
+            }
+            // The first poles of the levels are the low half, the last ones the high half.
+            low.poles[index(0)] = q[0];
+            high.poles[index(degree)] = q[degree];
+            for (int r = 1; r <= degree; ++r)
+            {
+                for (int k = 0; k <= degree - r; ++k)
+                {
+                    q[k] = 0.5 * (q[k] + q[k + 1]);
+                }
+                low.poles[index(r)] = q[0];
+                high.poles[index(degree - r)] = q[degree - r];
+            }
+        }
+        if (alongU)
+        {
+            low.u2 = high.u1 = 0.5 * (net.u1 + net.u2);
+            low.splitsU = high.splitsU = net.splitsU + 1;
+        }
+        else
+        {
+            low.v2 = high.v1 = 0.5 * (net.v1 + net.v2);
+            low.splitsV = high.splitsV = net.splitsV + 1;
+        }
+    }
+
+    // Refines the net into flat sub-patches of the patch, appended to elements.
+    void Refine(const Net& net, const int patch, std::vector<BVH_PatchTree::Element>& elements)
+    {
+        const int nbU = net.nbU, nbV = net.nbV;
+        std::vector<gp_Pnt> points(nbU * nbV);
+        Bnd_Box box;
+        for (int i = 0; i < nbU * nbV; ++i)
+        {
+            points[i] = gp_Pnt(net.poles[i]) / net.poles[i].w;
+            box.Add(points[i]);
+        }
+
+        // Distance to the bilinear patch of the corners, and second differences along u and v.
+        const gp_Pnt& p00 = points[0];
+        const gp_Pnt& p10 = points[(nbU - 1) * nbV];
+        const gp_Pnt& p01 = points[nbV - 1];
+        const gp_Pnt& p11 = points[nbU * nbV - 1];
+        double deviation = 0.0, curvatureU = 0.0, curvatureV = 0.0;
+        for (int i = 0; i < nbU; ++i)
+        {
+            const double s = static_cast<double>(i) / (nbU - 1);
+            for (int j = 0; j < nbV; ++j)
+            {
+                const double t = static_cast<double>(j) / (nbV - 1);
+                const gp_Pnt bilinear = (1.0 - s) * ((1.0 - t) * p00 + t * p01) + s * ((1.0 - t) * p10 + t * p11);
+                deviation = std::max(deviation, glm::distance(points[i * nbV + j], bilinear));
+                if (i > 0 && i < nbU - 1)
+                {
+                    curvatureU = std::max(curvatureU, glm::length(points[(i + 1) * nbV + j] - 2.0 * points[i * nbV + j] + points[(i - 1) * nbV + j]));
+                }
+                if (j > 0 && j < nbV - 1)
+                {
+                    curvatureV = std::max(curvatureV, glm::length(points[i * nbV + j + 1] - 2.0 * points[i * nbV + j] + points[i * nbV + j - 1]));
+                }
+            }
+        }
+
+        // The second derivatives are bounded by degree * (degree - 1) times the second differences.
+        curvatureU = net.splitsU < BVH_PatchTree::MaxNbSplits() ? (nbU - 1) * (nbU - 2) * curvatureU : -1.0;
+        curvatureV = net.splitsV < BVH_PatchTree::MaxNbSplits() ? (nbV - 1) * (nbV - 2) * curvatureV : -1.0;
+        const double diagonal = glm::distance(box.CornerMin(), box.CornerMax());
+        if (deviation <= Flatness * diagonal || (curvatureU <= 0.0 && curvatureV <= 0.0))
+        {
+            box.Enlarge(Precision::Confusion());
+            elements.push_back({box, patch, net.u1, net.u2, net.v1, net.v2});
+            return;
+        }
+
+        Net low, high;
+        Split(net, curvatureU >= curvatureV, low, high);
+        Refine(low, patch, elements);
+        Refine(high, patch, elements);
+    }
+
+    // Top-down builder of the tree, the nodes being allocated from a shared counter.
+    struct Builder
+    {
+        std::vector<BVH_PatchTree::Element>& elements;
+        std::vector<BVH_PatchTree::Node>& nodes;
+        std::atomic<int> nbNodes;
+        int parallelDepth;
+
+        // Builds the node of the elements [first, last[ and its subtree.
+        void Build(const int node, const int first, const int last, const int depth)
+        {
+            Bnd_Box box, centroids;
+            for (int i = first; i < last; ++i)
+            {
+                box.Add(elements[i].box);
+                centroids.Add(elements[i].box.Center());
+            }
+            BVH_PatchTree::Node& current = nodes[node];
+            current.box = box;
+            current.first = first;
+            current.count = last - first;
+            current.axis = 0;
+
+            const int count = last - first;
+            if (count == 1)
+            {
+                return;
+            }
+
+            // Cost of the best split between the bins of the centroids, relative to the cost of a leaf.
+            const double area = box.HalfArea();
+            double bestCost = std::numeric_limits<double>::infinity();
+            int bestAxis = -1, bestBin = 0;
+            auto binOf = [&](const BVH_PatchTree::Element& element, const int axis)
+            {
+                const double extent = centroids.CornerMax()[axis] - centroids.CornerMin()[axis];
+                const int bin = static_cast<int>(NbBins * (element.box.Center()[axis] - centroids.CornerMin()[axis]) / extent);
+                return std::min(bin, NbBins - 1);
+            };
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                if (centroids.CornerMax()[axis] - centroids.CornerMin()[axis] <= 0.0)
+                {
+                    continue;
+                }
+                int counts[NbBins] = {};
+                Bnd_Box boxes[NbBins];
+                for (int i = first; i < last; ++i)
+                {
+                    const int bin = binOf(elements[i], axis);
+                    ++counts[bin];
+                    boxes[bin].Add(elements[i].box);
+                }
+
+                // The costs of the right sides from the last bin, then of the splits from the first bin.
+                double rightCosts[NbBins];
+                Bnd_Box side;
+                int nbSide = 0;
+                for (int b = NbBins - 1; b > 0; --b)
+                {
+                    side.Add(boxes[b]);
+                    nbSide += counts[b];
+                    rightCosts[b] = side.HalfArea() * nbSide;
+                }
+                side = Bnd_Box();
+                nbSide = 0;
+                for (int b = 0; b < NbBins - 1; ++b)
+                {
+                    side.Add(boxes[b]);
+                    nbSide += counts[b];
+                    const double cost = side.HalfArea() * nbSide + rightCosts[b + 1];
+                    if (nbSide > 0 && nbSide < count && cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestBin = b;
+                    }
+                }
+            }
+            if (area > 0.0)
+            {
+                bestCost = TraversalCost + bestCost / area;
+            }
+            if (count <= BVH_PatchTree::MaxLeafSize() && (bestAxis < 0 || bestCost >= count))
+            {
+                return;
+            }
+
+            // Partition the elements by their bins, or at the median along the longest axis
+            // when the centroids are too close to be told apart.
+            int middle;
+            if (bestAxis >= 0)
+            {
+                middle = static_cast<int>(std::partition(elements.begin() + first, elements.begin() + last,
+                    [&](const BVH_PatchTree::Element& element)
+                    {
+                        return binOf(element, bestAxis) <= bestBin;
+                    }) - elements.begin());
+            }
+            else
+            {
+                const gp_Vec extent = box.CornerMax() - box.CornerMin();
+                bestAxis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+                middle = first + count / 2;
+                std::nth_element(elements.begin() + first, elements.begin() + middle, elements.begin() + last,
+                    [&](const BVH_PatchTree::Element& a, const BVH_PatchTree::Element& b)
+                    {
+                        return a.box.Center()[bestAxis] < b.box.Center()[bestAxis];
+                    });
+            }
+
+            const int children = nbNodes.fetch_add(2);
+            current.first = children;
+            current.count = 0;
+            current.axis = bestAxis;
+            if (depth < parallelDepth && count >= MinParallelSize)
+            {
+                std::thread thread([&]()
+                {
+                    Build(children, first, middle, depth + 1);
+                });
+                Build(children + 1, middle, last, depth + 1);
+                thread.join();
+            }
+            else
+            {
+                Build(children, first, middle, depth + 1);
+                Build(children + 1, middle, last, depth + 1);
+            }
+        }
+    };
+}
+
+BVH_PatchTree::BVH_PatchTree(const handle<Geom_BezierSurface>* patches, const int nbPatches)
+{
+    VALIDATE_ARGUMENT(nbPatches < 0, "nbPatches", "BVH_PatchTree: Number of patches is negative!");
+
+    m_patches.assign(patches, patches + nbPatches);
+
+    // Refine the patches into flat sub-patches
+    std::vector<std::vector<Element>> subPatches(nbPatches);
+    Parallel::For(nbPatches, Grain, [&](const int first, const int last)
+    {
+        for (int i = first; i < last; ++i)
+        {
+            const Geom_BezierSurface& patch = *patches[i];
+            Net net;
+            net.nbU = patch.NbUPoles();
+            net.nbV = patch.NbVPoles();
+            net.poles.resize(net.nbU * net.nbV);
+            for (int a = 0; a < net.nbU; ++a)
+            {
+                for (int b = 0; b < net.nbV; ++b)
+                {
+                    const double w = patch.Weight(a, b);
+                    net.poles[a * net.nbV + b] = gp_Pnt4d(w * patch.Pole(a, b), w);
+                }
+            }
+            patch.Bounds(net.u1, net.u2, net.v1, net.v2);
+            net.splitsU = net.splitsV = 0;
+            Refine(net, i, subPatches[i]);
+        }
+    });
+
+    size_t nbElements = 0;
+    for (const std::vector<Element>& elements : subPatches)
+    {
+        nbElements += elements.size();
+    }
+    m_elements.reserve(nbElements);
+    for (const std::vector<Element>& elements : subPatches)
+    {
+        m_elements.insert(m_elements.end(), elements.begin(), elements.end());
+    }
+    if (m_elements.empty())
+    {
+        return;
+    }
+
+    // Build the tree, a binary tree of n leaves has at most 2 n - 1 nodes
+    m_nodes.resize(2 * m_elements.size() - 1);
+    int parallelDepth = 0;
+    while ((1 << parallelDepth) < Parallel::NbThreads())
+    {
+        ++parallelDepth;
+    }
+    Builder builder = {m_elements, m_nodes, {1}, parallelDepth};
+    builder.Build(0, 0, static_cast<int>(m_elements.size()), 0);
+    m_nodes.resize(builder.nbNodes.load());
+}
@@ -0,0 +1,82 @@
+// Bounding volume hierarchy over a set of Bezier surface patches.
+// Each patch is first refined into sub-patches: its net of poles is split at the middle of u or v with the
+// de Casteljau algorithm until it is close to the bilinear patch of its corners. The sub-patches are bounded by
+// the boxes of their nets, which contain them as the weights are positive, and are the elements of the tree:
+// a ray which enters the box of a flat sub-patch is intersected by the Newton method from its center.
+// The tree is built top-down with the surface area heuristic on binned centroids, the subtrees of the first
+// levels in parallel. The nodes are stored in a flat array, the children of a node being consecutive.
+
+#ifndef BVH_PATCHTREE_H
+#define BVH_PATCHTREE_H
+
+#include "bnd_Box.h"
+#include "surface/geom_BezierSurface.h"
+
+class BVH_PatchTree
+{
+public:
+    // A node of the tree: a leaf holds the elements [first, first + count[, an inner node (count = 0)
+    // has the children first and first + 1, split along the axis.
+    struct Node
+    {
+        Bnd_Box box;
+        int first;
+        int count;
+        int axis;
+    };
+
+    // A sub-patch, the part [u1, u2] x [v1, v2] of the patch.
+    struct Element
+    {
+        Bnd_Box box;
+        int patch;
+        double u1, u2, v1, v2;
+    };
+
+    // Builds the tree of the nbPatches patches, which are shared with the tree.
+    // Raised if nbPatches is negative.
+    BVH_PatchTree(const handle<Geom_BezierSurface>* patches, const int nbPatches);
+
+    // Returns the number of patches.
+    inline int NbPatches() const
+    {
+        return static_cast<int>(m_patches.size());
+    }
+
+    // Returns the patch of range index.
+    inline const Geom_BezierSurface& Patch(const int index) const
+    {
+        return *m_patches[index];
+    }
+
+    // Returns the nodes, the root being the first one. The tree of no patch has no node.
+    inline const std::vector<Node>& Nodes() const
+    {
+        return m_nodes;
+    }
+
+    // Returns the elements, in the order of the leaves.
+    inline const std::vector<Element>& Elements() const
+    {
+        return m_elements;
+    }
+
+    // Returns the largest number of elements of a leaf. This value is 4.
+    constexpr static int MaxLeafSize()
+    {
+        return 4;
+    }
+
+    // Returns the largest number of splits of a patch in each direction. This value is 4.
+    constexpr static int MaxNbSplits()
+    {
+        return 4;
+    }
+
+private:
+    std::vector<handle<Geom_BezierSurface>> m_patches;
+    std::vector<Node> m_nodes;
+    std::vector<Element> m_elements;
+};
+
+#endif
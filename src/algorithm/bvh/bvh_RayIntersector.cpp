@@ -0,0 +1,182 @@
+#include "bvh_RayIntersector.h"
+#include "exceptions.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    constexpr int NbPacketRays = BVH_RayIntersector::PacketSize();
+
+    // Number of packets in a chunk of the parallel loop.
+    constexpr int Grain = 8;
+
+    // Rays of a packet stored by coordinates.
+    struct Packet
+    {
+        int nbRays;
+        double ox[NbPacketRays], oy[NbPacketRays], oz[NbPacketRays];
+        double ix[NbPacketRays], iy[NbPacketRays], iz[NbPacketRays];
+        double tMax[NbPacketRays];
+    };
+
+    // Tests the rays of the packet against the box: entered[r] is true if the ray r enters the box
+    // before its nearest hit so far. Returns true if one ray enters the box.
+    bool Enter(const Packet& packet, const Bnd_Box& box, bool* entered)
+    {
+        const gp_Pnt& min = box.CornerMin();
+        const gp_Pnt& max = box.CornerMax();
+        bool any = false;
+        for (int r = 0; r < packet.nbRays; ++r)
+        {
+            const double x1 = (min.x - packet.ox[r]) * packet.ix[r], x2 = (max.x - packet.ox[r]) * packet.ix[r];
+            const double y1 = (min.y - packet.oy[r]) * packet.iy[r], y2 = (max.y - packet.oy[r]) * packet.iy[r];
+            const double z1 = (min.z - packet.oz[r]) * packet.iz[r], z2 = (max.z - packet.oz[r]) * packet.iz[r];
+            const double tNear = std::max(std::max(std::min(x1, x2), std::min(y1, y2)), std::max(std::min(z1, z2), 0.0));
+            const double tFar = std::min(std::min(std::max(x1, x2), std::max(y1, y2)), std::min(std::max(z1, z2), packet.tMax[r]));
+            entered[r] = tNear <= tFar;
+            any = any || entered[r];
+        }
+        return any;
+    }
+}
+
+BVH_RayIntersector::BVH_RayIntersector(const BVH_PatchTree& tree)
+    : m_tree(tree)
+{
+}
+
+bool BVH_RayIntersector::Intersect(const BVH_PatchTree::Element& element, const gp_Pnt& origin, const gp_Vec& direction,
+                                   const gp_Vec& n1, const gp_Vec& n2, BVH_RayHit& hit) const
+{
+    const Geom_BezierSurface& patch = m_tree.Patch(element.patch);
+    double u1, u2, v1, v2;
+    patch.Bounds(u1, u2, v1, v2);
+
+    // The iterations which leave the neighbourhood of the sub-patch diverge. They may cross the bounds of the patch,
+    // whose polynomials extend beyond, as the hits near the sides are approached from both sides.
+    const double du = element.u2 - element.u1, dv = element.v2 - element.v1;
+    const double uMin = element.u1 - du, uMax = element.u2 + du;
+    const double vMin = element.v1 - dv, vMax = element.v2 + dv;
+
+    const double d1 = -glm::dot(n1, origin), d2 = -glm::dot(n2, origin);
+    double u = 0.5 * (element.u1 + element.u2), v = 0.5 * (element.v1 + element.v2);
+    for (int i = 0; i < MaxNbIterations(); ++i)
+    {
+        gp_Pnt p;
+        gp_Vec d1u, d1v;
+        patch.D1(u, v, p, d1u, d1v);
+        const double f1 = glm::dot(n1, p) + d1, f2 = glm::dot(n2, p) + d2;
+        if (std::abs(f1) + std::abs(f2) <= Precision::Confusion())
+        {
+            const double tolerance = Precision::PConfusion();
+            if (u < u1 - tolerance || u > u2 + tolerance || v < v1 - tolerance || v > v2 + tolerance)
+            {
+                return false;
+            }
+            hit = {element.patch, std::min(std::max(u, u1), u2), std::min(std::max(v, v1), v2),
+                   glm::dot(p - origin, direction) / glm::dot(direction, direction)};
+            return hit.t >= 0.0;
+        }
+
+        const double j11 = glm::dot(n1, d1u), j12 = glm::dot(n1, d1v);
+        const double j21 = glm::dot(n2, d1u), j22 = glm::dot(n2, d1v);
+        const double det = j11 * j22 - j12 * j21;
+        if (std::abs(det) <= gp_Resolution)
+        {
+            return false;
+        }
+        u -= (f1 * j22 - f2 * j12) / det;
+        v -= (j11 * f2 - j21 * f1) / det;
+        if (u < uMin || u > uMax || v < vMin || v > vMax)
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+void BVH_RayIntersector::Perform(const gp_SoAOfXYZ& origins, const gp_SoAOfXYZ& directions, const int nbRays, BVH_RayHit* hits) const
+{
+    VALIDATE_ARGUMENT(nbRays < 0, "nbRays", "BVH_RayIntersector: Number of rays is negative!");
+
+    const std::vector<BVH_PatchTree::Node>& nodes = m_tree.Nodes();
+    const std::vector<BVH_PatchTree::Element>& elements = m_tree.Elements();
+    const int nbPackets = (nbRays + NbPacketRays - 1) / NbPacketRays;
+    Parallel::For(nbPackets, Grain, [&](const int firstPacket, const int lastPacket)
+    {
+        Packet packet;
+        std::vector<int> stack;
+        bool entered[NbPacketRays];
+        gp_Vec n1[NbPacketRays], n2[NbPacketRays];
+        for (int k = firstPacket; k < lastPacket; ++k)
+        {
+            const int first = k * NbPacketRays;
+            packet.nbRays = std::min(NbPacketRays, nbRays - first);
+            for (int r = 0; r < packet.nbRays; ++r)
+            {
+                const gp_Vec direction = directions.Value(first + r);
+                packet.ox[r] = origins.x[first + r];
+                packet.oy[r] = origins.y[first + r];
+                packet.oz[r] = origins.z[first + r];
+                packet.ix[r] = 1.0 / direction.x;
+                packet.iy[r] = 1.0 / direction.y;
+                packet.iz[r] = 1.0 / direction.z;
+                packet.tMax[r] = std::numeric_limits<double>::infinity();
+                hits[first + r] = {-1, 0.0, 0.0, std::numeric_limits<double>::infinity()};
+
+                // Planes through the ray, orthogonal to each other.
+                const gp_Vec d = glm::normalize(direction);
+                n1[r] = std::abs(d.x) > std::abs(d.y) && std::abs(d.x) > std::abs(d.z)
+                        ? glm::normalize(gp_Vec(d.y, -d.x, 0.0)) : glm::normalize(gp_Vec(0.0, d.z, -d.y));
+                n2[r] = glm::cross(n1[r], d);
+            }
+            if (nodes.empty())
+            {
+                continue;
+            }
+
+            stack.assign(1, 0);
+            while (!stack.empty())
+            {
+                const BVH_PatchTree::Node& node = nodes[stack.back()];
+                stack.pop_back();
+                if (!Enter(packet, node.box, entered))
+                {
+                    continue;
+                }
+
+                if (node.count == 0)
+                {
+                    // Visit first the child on the side of the origins, for the direction of the first entering ray.
+                    const int r = static_cast<int>(std::find(entered, entered + packet.nbRays, true) - entered);
+                    const double inverse = node.axis == 0 ? packet.ix[r] : (node.axis == 1 ? packet.iy[r] : packet.iz[r]);
+                    stack.push_back(inverse < 0.0 ? node.first : node.first + 1);
+                    stack.push_back(inverse < 0.0 ? node.first + 1 : node.first);
+                    continue;
+                }
+
+                for (int e = node.first; e < node.first + node.count; ++e)
+                {
+                    const BVH_PatchTree::Element& element = elements[e];
+                    if (node.count > 1 && !Enter(packet, element.box, entered))
+                    {
+                        continue;
+                    }
+                    for (int r = 0; r < packet.nbRays; ++r)
+                    {
+                        BVH_RayHit hit;
+                        if (entered[r] && Intersect(element, origins.Value(first + r), directions.Value(first + r), n1[r], n2[r], hit)
+                            && hit.t < packet.tMax[r])
+                        {
+                            hits[first + r] = hit;
+                            packet.tMax[r] = hit.t;
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,57 @@
+// Intersects batches of rays with the patches of a bounding volume hierarchy.
+// The rays are traced in packets of consecutive rays, which descend the tree together: a node is visited
+// when one ray of the packet enters its box before its nearest hit so far, and the boxes are tested for all
+// the rays of the packet at once on coordinates stored by rays. In a leaf, each ray which enters the box of
+// a sub-patch is intersected with it by the Newton method from the center of the sub-patch, the ray being
+// the intersection of two orthogonal planes: the two plane equations of S(u, v) are solved for (u, v).
+// Coherent rays, as the rays of neighbouring pixels, visit the same nodes and share the box tests.
+
+#ifndef BVH_RAYINTERSECTOR_H
+#define BVH_RAYINTERSECTOR_H
+
+#include "bvh_PatchTree.h"
+
+// The nearest hit of a ray: the patch, -1 if the ray misses, the parameters (u, v) of the point on the patch
+// and the parameter t of the point on the ray, origin + t * direction.
+struct BVH_RayHit
+{
+    int patch;
+    double u;
+    double v;
+    double t;
+};
+
+class BVH_RayIntersector
+{
+public:
+    // Creates an intersector of the tree, which must outlive it.
+    explicit BVH_RayIntersector(const BVH_PatchTree& tree);
+
+    // Intersects the nbRays rays origins[i] + t * directions[i], t >= 0, with the patches of the tree and writes
+    // the nearest hits in hits[0], ..., hits[nbRays - 1]. The packets are traced in parallel.
+    // Raised if nbRays is negative.
+    void Perform(const gp_SoAOfXYZ& origins, const gp_SoAOfXYZ& directions, const int nbRays, BVH_RayHit* hits) const;
+
+    // Returns the number of rays of a packet. This value is 8.
+    constexpr static int PacketSize()
+    {
+        return 8;
+    }
+
+    // Returns the largest number of iterations of the Newton method. This value is 12.
+    constexpr static int MaxNbIterations()
+    {
+        return 12;
+    }
+
+private:
+    // Intersects the ray of the origin, the direction and the planes of normals n1 and n2 through the ray with
+    // the sub-patch, and returns true with the hit if the method converges on the patch at a parameter t >= 0.
+    bool Intersect(const BVH_PatchTree::Element& element, const gp_Pnt& origin, const gp_Vec& direction,
+                   const gp_Vec& n1, const gp_Vec& n2, BVH_RayHit& hit) const;
+
+private:
+    const BVH_PatchTree& m_tree;
+};
+
+#endif
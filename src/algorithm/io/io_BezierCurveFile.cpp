@@ -0,0 +1,146 @@
+#include "io_BezierCurveFile.h"
+#include "exceptions.h"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+
+namespace
+{
+    static_assert(sizeof(gp_Pnt) == 3 * sizeof(double) && std::is_trivially_copyable<gp_Pnt>::value,
+                  "The poles are read in place as three doubles.");
+
+    constexpr char Magic[8] = {'N', 'U', 'R', 'B', 'S', 'B', 'E', 'Z'};
+
+    // Written in the byte order of the machine: it reads back swapped from a file of the other order,
+    // which is detected and rejected.
+    constexpr uint32_t ByteOrderMark = 0x01020304;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t nbCurves;
+        uint64_t nbPoles;
+        uint64_t nbWeights;
+
+        // Positions of the arrays in bytes from the start of the file.
+        uint64_t poles;
+        uint64_t weights;
+        uint64_t offsets;
+        uint64_t weightOffsets;
+    };
+
+    // Returns the position rounded up to the alignment of the arrays.
+    inline uint64_t Align(const uint64_t position)
+    {
+        const uint64_t alignment = IO_BezierCurveFile::Alignment();
+        return (position + alignment - 1) / alignment * alignment;
+    }
+
+    // Returns true if the array of count elements of size bytes at the position is aligned and inside the file.
+    inline bool IsInside(const uint64_t position, const uint64_t count, const uint64_t size, const size_t fileSize)
+    {
+        return position % IO_BezierCurveFile::Alignment() == 0 && position <= fileSize
+            && count <= (fileSize - position) / size;
+    }
+}
+
+void IO_BezierCurveFile::Write(const Geom_BezierCurveSet& curves, const std::string& path)
+{
+    // Gather the weights of the rational curves and their offsets
+    const int nbCurves = curves.NbCurves();
+    std::vector<double> weights;
+    std::vector<int32_t> offsets(nbCurves + 1), weightOffsets(nbCurves);
+    for (int i = 0; i < nbCurves; ++i)
+    {
+        const Geom_BezierCurveView curve = curves.Curve(i);
+        offsets[i] = curves.Offset(i);
+        weightOffsets[i] = curve.IsRational() ? static_cast<int32_t>(weights.size()) : -1;
+        if (curve.IsRational())
+        {
+            weights.insert(weights.end(), curve.Weights(), curve.Weights() + curve.NbPoles());
+        }
+    }
+    offsets[nbCurves] = curves.NbPoles();
+
+    Header header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version();
+    header.byteOrder = ByteOrderMark;
+    header.nbCurves = nbCurves;
+    header.nbPoles = curves.NbPoles();
+    header.nbWeights = weights.size();
+    header.poles = Align(sizeof(Header));
+    header.weights = Align(header.poles + header.nbPoles * sizeof(gp_Pnt));
+    header.offsets = Align(header.weights + header.nbWeights * sizeof(double));
+    header.weightOffsets = Align(header.offsets + offsets.size() * sizeof(int32_t));
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    VALIDATE_FILE(!stream, path, "IO_BezierCurveFile: Cannot create the file!");
+
+    // Each array is preceded by the padding up to its position.
+    uint64_t position = 0;
+    const char padding[Alignment()] = {};
+    auto write = [&](const uint64_t start, const void* data, const uint64_t size)
+    {
+        stream.write(padding, static_cast<std::streamsize>(start - position));
+        stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        position = start + size;
+    };
+    write(0, &header, sizeof(Header));
+    write(header.poles, curves.Poles(), header.nbPoles * sizeof(gp_Pnt));
+    write(header.weights, weights.data(), header.nbWeights * sizeof(double));
+    write(header.offsets, offsets.data(), offsets.size() * sizeof(int32_t));
+    write(header.weightOffsets, weightOffsets.data(), weightOffsets.size() * sizeof(int32_t));
+    stream.close();
+    VALIDATE_FILE(!stream, path, "IO_BezierCurveFile: Cannot write the file!");
+}
+
+IO_BezierCurveFile::IO_BezierCurveFile(const std::string& path)
+    : m_path(path),
+      m_file(path)
+{
+    const size_t size = m_file.Size();
+    VALIDATE_FILE(size < sizeof(Header), path, "IO_BezierCurveFile: File is too small for a header!");
+
+    Header header;
+    std::memcpy(&header, m_file.Data(), sizeof(Header));
+    VALIDATE_FILE(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0, path, "IO_BezierCurveFile: File is not a curve file!");
+    VALIDATE_FILE(header.byteOrder != ByteOrderMark, path, "IO_BezierCurveFile: File has another byte order!");
+    VALIDATE_FILE(header.version != static_cast<uint32_t>(Version()), path, "IO_BezierCurveFile: Version of the file is not supported!");
+
+    const uint64_t maxCount = static_cast<uint64_t>(std::numeric_limits<int32_t>::max()) - 1;
+    VALIDATE_FILE(header.nbCurves > maxCount || header.nbPoles > maxCount || header.nbWeights > maxCount, path,
+                  "IO_BezierCurveFile: Numbers of the file are too large!");
+    VALIDATE_FILE(!IsInside(header.poles, header.nbPoles, sizeof(gp_Pnt), size)
+                  || !IsInside(header.weights, header.nbWeights, sizeof(double), size)
+                  || !IsInside(header.offsets, header.nbCurves + 1, sizeof(int32_t), size)
+                  || !IsInside(header.weightOffsets, header.nbCurves, sizeof(int32_t), size), path,
+                  "IO_BezierCurveFile: Arrays of the file are outside of the file!");
+
+    m_nbCurves = static_cast<int>(header.nbCurves);
+    m_nbPoles = static_cast<int>(header.nbPoles);
+    m_nbWeights = static_cast<int>(header.nbWeights);
+    m_poles = reinterpret_cast<const gp_Pnt*>(m_file.Data() + header.poles);
+    m_weights = reinterpret_cast<const double*>(m_file.Data() + header.weights);
+    m_offsets = reinterpret_cast<const int32_t*>(m_file.Data() + header.offsets);
+    m_weightOffsets = reinterpret_cast<const int32_t*>(m_file.Data() + header.weightOffsets);
+    VALIDATE_FILE(m_offsets[0] != 0 || m_offsets[m_nbCurves] != m_nbPoles, path, "IO_BezierCurveFile: Offsets of the file are invalid!");
+}
+
+Geom_BezierCurveView IO_BezierCurveFile::Curve(const int index) const
+{
+    VALIDATE_ARGUMENT_RANGE(index, 0, NbCurves() - 1);
+
+    // The offsets are checked on access only, so that opening the file reads no array.
+    const int first = m_offsets[index], degree = Degree(index);
+    VALIDATE_FILE(first < 0 || degree < 1 || degree > Geom_BezierCurve::MaxDegree() || first > m_nbPoles - degree - 1, m_path,
+                  "IO_BezierCurveFile: Poles of the curve are outside of the file!");
+    const int weights = m_weightOffsets[index];
+    VALIDATE_FILE(weights >= 0 && weights > m_nbWeights - degree - 1, m_path, "IO_BezierCurveFile: Weights of the curve are outside of the file!");
+
+    return Geom_BezierCurveView(m_poles + first, weights >= 0 ? m_weights + weights : nullptr, degree);
+}
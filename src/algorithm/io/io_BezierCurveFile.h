@@ -0,0 +1,139 @@
+// Binary file of Bezier curves, read in place through a memory mapping.
+// The file stores the flat arrays of a Geom_BezierCurveSet, each one aligned on Alignment() bytes:
+// - a header: the magic "NURBSBEZ", the version, a byte order mark, the numbers of curves, poles
+//   and weights, and the positions in bytes of the four arrays,
+// - the poles of all the curves, three doubles each,
+// - the weights of the rational curves,
+// - the NbCurves() + 1 offsets of the first poles of the curves, 32-bit integers, whose differences
+//   are the degrees plus one,
+// - the offsets of the first weights of the curves, -1 for a non-rational curve.
+// The numbers are in the byte order of the machine which wrote the file; a file of the other order is
+// rejected. Opening a file checks the header only: the pages of the arrays are read from the disk on the
+// first access to their curves, whose views point straight into the mapping, without allocation or copy.
+
+#ifndef IO_BEZIERCURVEFILE_H
+#define IO_BEZIERCURVEFILE_H
+
+#include "curve/geom_BezierCurveSet.h"
+#include "mappedFile.h"
+
+#include <cstdint>
+#include <string>
+
+class IO_BezierCurveFile
+{
+public:
+    // Forward iterator on the views of the curves.
+    class Iterator
+    {
+    public:
+        Iterator(const IO_BezierCurveFile& file, const int index)
+            : m_file(&file),
+              m_index(index)
+        {
+        }
+
+        inline Geom_BezierCurveView operator*() const
+        {
+            return m_file->Curve(m_index);
+        }
+
+        inline Iterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        inline bool operator!=(const Iterator& other) const
+        {
+            return m_index != other.m_index;
+        }
+
+    private:
+        const IO_BezierCurveFile* m_file;
+        int m_index;
+    };
+
+    // Writes the curves of the set to the file of the path, replacing it.
+    // Raised if the file cannot be written.
+    static void Write(const Geom_BezierCurveSet& curves, const std::string& path);
+
+    // Maps the file of the path.
+    // Raised if the file cannot be mapped, or if its header is not the one of a curve file of this version.
+    explicit IO_BezierCurveFile(const std::string& path);
+
+    // Returns the number of curves.
+    inline int NbCurves() const
+    {
+        return m_nbCurves;
+    }
+
+    // Returns the number of poles of all the curves.
+    inline int NbPoles() const
+    {
+        return m_nbPoles;
+    }
+
+    // Returns the index of the first pole of the curve index, Offset(NbCurves()) is NbPoles().
+    inline int Offset(const int index) const
+    {
+        return m_offsets[index];
+    }
+
+    // Returns the degree of the curve index.
+    inline int Degree(const int index) const
+    {
+        return m_offsets[index + 1] - m_offsets[index] - 1;
+    }
+
+    // Returns true if the curve index has weights.
+    inline bool IsRational(const int index) const
+    {
+        return m_weightOffsets[index] >= 0;
+    }
+
+    // Returns the view of the curve index over the mapped file, valid as long as this object.
+    // Raised if index is not in the range [0, NbCurves() - 1], or if the curve lies outside of the arrays of the file.
+    Geom_BezierCurveView Curve(const int index) const;
+
+    // Returns the poles of all the curves.
+    inline const gp_Pnt* Poles() const
+    {
+        return m_poles;
+    }
+
+    inline Iterator begin() const
+    {
+        return Iterator(*this, 0);
+    }
+
+    inline Iterator end() const
+    {
+        return Iterator(*this, NbCurves());
+    }
+
+    // Returns the version of the files written and read. This value is 1.
+    constexpr static int Version()
+    {
+        return 1;
+    }
+
+    // Returns the alignment in bytes of the arrays in the file. This value is 64, the size of a cache line.
+    constexpr static int Alignment()
+    {
+        return 64;
+    }
+
+private:
+    std::string m_path;
+    MappedFile m_file;
+    int m_nbCurves;
+    int m_nbPoles;
+    int m_nbWeights;
+    const gp_Pnt* m_poles;
+    const double* m_weights;
+    const int32_t* m_offsets;
+    const int32_t* m_weightOffsets;
+};
+
+#endif
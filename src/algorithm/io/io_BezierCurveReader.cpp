@@ -0,0 +1,125 @@
+#include "io_BezierCurveReader.h"
+#include "exceptions.h"
+
+#include <cstring>
+#include <limits>
+
+IO_BezierCurveReader::IO_BezierCurveReader(const std::string& path, const bool prefetch)
+    : m_path(path),
+      m_stream(path, std::ios::binary),
+      m_chunkSize(0),
+      m_prefetch(prefetch),
+      m_ended(false)
+{
+    VALIDATE_FILE(!m_stream, path, "IO_BezierCurveReader: Cannot open the file!");
+
+    IO_BezierCurveStream::Header header;
+    m_stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+    VALIDATE_FILE(!m_stream, path, "IO_BezierCurveReader: File is too small for a header!");
+    VALIDATE_FILE(std::memcmp(header.magic, IO_BezierCurveStream::Magic(), sizeof(header.magic)) != 0, path,
+                  "IO_BezierCurveReader: File is not a stream file!");
+    VALIDATE_FILE(header.byteOrder != IO_BezierCurveStream::ByteOrderMark(), path, "IO_BezierCurveReader: File has another byte order!");
+    VALIDATE_FILE(header.version != static_cast<uint32_t>(IO_BezierCurveStream::Version()), path,
+                  "IO_BezierCurveReader: Version of the file is not supported!");
+    VALIDATE_FILE(header.chunkSize < static_cast<uint64_t>(Geom_BezierCurve::MaxDegree() + 1)
+                  || header.chunkSize > static_cast<uint64_t>(std::numeric_limits<int32_t>::max()), path,
+                  "IO_BezierCurveReader: Chunk size of the file is invalid!");
+    m_chunkSize = static_cast<int>(header.chunkSize);
+
+    if (m_prefetch)
+    {
+        m_next = std::async(std::launch::async, [this]()
+        {
+            Read(m_nextRecords);
+        });
+    }
+}
+
+IO_BezierCurveReader::~IO_BezierCurveReader()
+{
+    if (m_next.valid())
+    {
+        m_next.wait();
+    }
+}
+
+bool IO_BezierCurveReader::Next(Geom_BezierCurveSet& chunk)
+{
+    chunk.Clear();
+    if (m_ended)
+    {
+        return false;
+    }
+
+    // The records of the chunk, then the next ones in the background while the chunk is decoded and processed
+    try
+    {
+        if (m_prefetch)
+        {
+            m_next.get();
+            std::swap(m_records, m_nextRecords);
+        }
+        else
+        {
+            Read(m_records);
+        }
+    }
+    catch (const std::exception&)
+    {
+        m_ended = true;
+        throw;
+    }
+    const IO_BezierCurveStream::ChunkHeader& header = m_records.header;
+    if (header.nbCurves == 0)
+    {
+        m_ended = true;
+        return false;
+    }
+    if (m_prefetch)
+    {
+        m_next = std::async(std::launch::async, [this]()
+        {
+            Read(m_nextRecords);
+        });
+    }
+
+    // The poles come first in the buffer, aligned as any allocation.
+    const unsigned char* bytes = m_records.bytes.data();
+    const gp_Pnt* poles = reinterpret_cast<const gp_Pnt*>(bytes);
+    const double* weights = reinterpret_cast<const double*>(bytes + header.nbPoles * sizeof(gp_Pnt));
+    const int32_t* degrees = reinterpret_cast<const int32_t*>(bytes + header.nbPoles * sizeof(gp_Pnt) + header.nbWeights * sizeof(double));
+    const unsigned char* rationals = reinterpret_cast<const unsigned char*>(degrees + header.nbCurves);
+
+    int pole = 0, weight = 0;
+    const int nbPoles = static_cast<int>(header.nbPoles), nbWeights = static_cast<int>(header.nbWeights);
+    for (uint32_t i = 0; i < header.nbCurves; ++i)
+    {
+        const int nbCurvePoles = degrees[i] + 1;
+        VALIDATE_FILE(degrees[i] < 1 || degrees[i] > Geom_BezierCurve::MaxDegree() || pole > nbPoles - nbCurvePoles
+                      || (rationals[i] && weight > nbWeights - nbCurvePoles), m_path,
+                      "IO_BezierCurveReader: Curves of the chunk are invalid!");
+        chunk.Append(poles + pole, nbCurvePoles, rationals[i] ? weights + weight : nullptr);
+        pole += nbCurvePoles;
+        weight += rationals[i] ? nbCurvePoles : 0;
+    }
+    VALIDATE_FILE(pole != nbPoles || weight != nbWeights, m_path, "IO_BezierCurveReader: Curves of the chunk are invalid!");
+    return true;
+}
+
+void IO_BezierCurveReader::Read(Records& records)
+{
+    IO_BezierCurveStream::ChunkHeader& header = records.header;
+    m_stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+    VALIDATE_FILE(!m_stream, m_path, "IO_BezierCurveReader: File is truncated!");
+    if (header.nbCurves == 0)
+    {
+        return;
+    }
+
+    // The sizes are checked before the allocation, which the chunk size bounds.
+    VALIDATE_FILE(header.nbPoles > static_cast<uint32_t>(m_chunkSize) || header.nbWeights > header.nbPoles
+                  || header.nbCurves > header.nbPoles / 2, m_path, "IO_BezierCurveReader: Sizes of the chunk are invalid!");
+    records.bytes.resize(IO_BezierCurveStream::ChunkBytes(header.nbCurves, header.nbPoles, header.nbWeights));
+    m_stream.read(reinterpret_cast<char*>(records.bytes.data()), static_cast<std::streamsize>(records.bytes.size()));
+    VALIDATE_FILE(!m_stream, m_path, "IO_BezierCurveReader: File is truncated!");
+}
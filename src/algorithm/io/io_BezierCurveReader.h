@@ -0,0 +1,77 @@
+// Reads the Bezier curves of a stream file chunk by chunk, see IO_BezierCurveStream.
+// Each chunk is read into a Geom_BezierCurveSet, reused from chunk to chunk, so that the memory of the reader
+// is bounded by the chunk size of the file whatever its number of curves. With the prefetch, the records
+// of the next chunk are read on a separate thread while the caller processes the current one.
+
+#ifndef IO_BEZIERCURVEREADER_H
+#define IO_BEZIERCURVEREADER_H
+
+#include "io_BezierCurveStream.h"
+#include "curve/geom_BezierCurveSet.h"
+
+#include <fstream>
+#include <future>
+#include <string>
+
+class IO_BezierCurveReader
+{
+public:
+    // Opens the stream file of the path, and reads the next chunk in the background if prefetch is true.
+    // Raised if the file cannot be opened, or if its header is not the one of a stream file of this version.
+    IO_BezierCurveReader(const std::string& path, const bool prefetch);
+
+    IO_BezierCurveReader(const IO_BezierCurveReader&) = delete;
+    IO_BezierCurveReader& operator=(const IO_BezierCurveReader&) = delete;
+
+    // Waits for the chunk being prefetched.
+    ~IO_BezierCurveReader();
+
+    // Replaces the curves of chunk by the curves of the next chunk of the file.
+    // Returns false, chunk being empty, at the end of the file.
+    // Raised if the file cannot be read or if the chunk is invalid.
+    bool Next(Geom_BezierCurveSet& chunk);
+
+    // Calls func(chunk) on the chunks of the curves of the file, from the current one, as a const Geom_BezierCurveSet&.
+    template <typename Func>
+    void ForEach(const Func& func);
+
+    // Returns the largest number of poles of a chunk of the file.
+    inline int ChunkSize() const
+    {
+        return m_chunkSize;
+    }
+
+private:
+    // Records of a chunk as they are in the file.
+    struct Records
+    {
+        IO_BezierCurveStream::ChunkHeader header;
+        std::vector<unsigned char> bytes;
+    };
+
+    // Reads the records of the next chunk of the file.
+    void Read(Records& records);
+
+private:
+    std::string m_path;
+    std::ifstream m_stream;
+    int m_chunkSize;
+    bool m_prefetch;
+    bool m_ended;
+    Records m_records;
+    Records m_nextRecords;
+    std::future<void> m_next;
+};
+
+template <typename Func>
+void IO_BezierCurveReader::ForEach(const Func& func)
+{
+    Geom_BezierCurveSet chunk;
+    chunk.Reserve(m_chunkSize / 2, m_chunkSize);
+    while (Next(chunk))
+    {
+        func(static_cast<const Geom_BezierCurveSet&>(chunk));
+    }
+}
+
+#endif
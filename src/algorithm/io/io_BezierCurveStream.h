@@ -0,0 +1,64 @@
+// Stream file of Bezier curves, written and read in chunks of bounded size, for the models larger than the memory.
+// The file is a header followed by chunks, each one holding whole curves of at most ChunkSize() poles in total:
+// - the chunk header: the numbers of curves, poles and weights of the chunk,
+// - the poles of the curves of the chunk, three doubles each,
+// - the weights of its rational curves,
+// - the degrees of its curves, 32-bit integers,
+// - the rational flags of its curves, one byte each.
+// A chunk of no curve ends the file. The numbers are in the byte order of the machine which wrote the file.
+// Unlike IO_BezierCurveFile, the file is written without knowing the number of curves and read front to back:
+// the writer and the reader hold one chunk, two with the prefetch, whatever the size of the file.
+// A chunk is read as a Geom_BezierCurveSet, evaluated in batch by Geom_BezierSampler.
+
+#ifndef IO_BEZIERCURVESTREAM_H
+#define IO_BEZIERCURVESTREAM_H
+
+#include <cstdint>
+
+class IO_BezierCurveStream
+{
+public:
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+
+        // Largest number of poles of a chunk.
+        uint64_t chunkSize;
+    };
+
+    struct ChunkHeader
+    {
+        uint32_t nbCurves;
+        uint32_t nbPoles;
+        uint32_t nbWeights;
+        uint32_t reserved;
+    };
+
+    // Returns the magic of the stream files.
+    static const char* Magic()
+    {
+        return "NURBSBZS";
+    }
+
+    // Returns the byte order mark, read back swapped on a machine of the other byte order.
+    constexpr static uint32_t ByteOrderMark()
+    {
+        return 0x01020304;
+    }
+
+    // Returns the version of the files written and read. This value is 1.
+    constexpr static int Version()
+    {
+        return 1;
+    }
+
+    // Returns the size in bytes of the records of a chunk of the numbers of curves, poles and weights.
+    constexpr static uint64_t ChunkBytes(const uint64_t nbCurves, const uint64_t nbPoles, const uint64_t nbWeights)
+    {
+        return nbPoles * 3 * sizeof(double) + nbWeights * sizeof(double) + nbCurves * (sizeof(int32_t) + 1);
+    }
+};
+
+#endif
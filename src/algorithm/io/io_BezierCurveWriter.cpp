@@ -0,0 +1,122 @@
+#include "io_BezierCurveWriter.h"
+#include "exceptions.h"
+
+#include <cstring>
+
+IO_BezierCurveWriter::IO_BezierCurveWriter(const std::string& path, const int chunkSize)
+    : m_path(path),
+      m_chunkSize(chunkSize),
+      m_nbCurves(0)
+{
+    VALIDATE_ARGUMENT(chunkSize < Geom_BezierCurve::MaxDegree() + 1, "chunkSize", "IO_BezierCurveWriter: Chunk size is lower than MaxDegree() + 1!");
+
+    m_stream.open(path, std::ios::binary | std::ios::trunc);
+    VALIDATE_FILE(!m_stream, path, "IO_BezierCurveWriter: Cannot create the file!");
+
+    IO_BezierCurveStream::Header header = {};
+    std::memcpy(header.magic, IO_BezierCurveStream::Magic(), sizeof(header.magic));
+    header.version = IO_BezierCurveStream::Version();
+    header.byteOrder = IO_BezierCurveStream::ByteOrderMark();
+    header.chunkSize = static_cast<uint64_t>(chunkSize);
+    m_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    VALIDATE_FILE(!m_stream, path, "IO_BezierCurveWriter: Cannot write the file!");
+
+    // The chunk is allocated once, a chunk holds at most one curve per two poles.
+    m_chunk.Reserve(chunkSize / 2, chunkSize);
+    m_degrees.reserve(chunkSize / 2);
+    m_rationals.reserve(chunkSize / 2);
+}
+
+IO_BezierCurveWriter::~IO_BezierCurveWriter()
+{
+    if (m_stream.is_open())
+    {
+        try
+        {
+            Close();
+        }
+        catch (const std::exception&)
+        {
+        }
+    }
+}
+
+void IO_BezierCurveWriter::Write(const gp_Pnt* poles, const int nbPoles, const double* weights)
+{
+    VALIDATE_FILE(!m_stream.is_open(), m_path, "IO_BezierCurveWriter: File is closed!");
+
+    if (m_chunk.NbPoles() + nbPoles > m_chunkSize)
+    {
+        Flush();
+    }
+    m_chunk.Append(poles, nbPoles, weights);
+    ++m_nbCurves;
+}
+
+void IO_BezierCurveWriter::Write(const Geom_BezierCurve& curve)
+{
+    double weights[Geom_BezierCurve::MaxDegree() + 1];
+    for (int i = 0; i < curve.NbPoles(); ++i)
+    {
+        weights[i] = curve.Weight(i);
+    }
+    Write(curve.PolesData(), curve.NbPoles(), curve.IsRational() ? weights : nullptr);
+}
+
+void IO_BezierCurveWriter::Write(const Geom_BezierCurveView& curve)
+{
+    Write(curve.Poles(), curve.NbPoles(), curve.Weights());
+}
+
+void IO_BezierCurveWriter::Write(const Geom_BezierCurveSet& curves)
+{
+    for (const Geom_BezierCurveView curve : curves)
+    {
+        Write(curve);
+    }
+}
+
+void IO_BezierCurveWriter::Close()
+{
+    VALIDATE_FILE(!m_stream.is_open(), m_path, "IO_BezierCurveWriter: File is closed!");
+
+    // The last chunk, then the empty chunk of the end
+    if (m_chunk.NbCurves() > 0)
+    {
+        Flush();
+    }
+    const IO_BezierCurveStream::ChunkHeader end = {};
+    m_stream.write(reinterpret_cast<const char*>(&end), sizeof(end));
+    m_stream.close();
+    VALIDATE_FILE(!m_stream, m_path, "IO_BezierCurveWriter: Cannot write the file!");
+}
+
+void IO_BezierCurveWriter::Flush()
+{
+    IO_BezierCurveStream::ChunkHeader header = {};
+    header.nbCurves = static_cast<uint32_t>(m_chunk.NbCurves());
+    header.nbPoles = static_cast<uint32_t>(m_chunk.NbPoles());
+    m_degrees.clear();
+    m_rationals.clear();
+    for (int i = 0; i < m_chunk.NbCurves(); ++i)
+    {
+        m_degrees.push_back(m_chunk.Degree(i));
+        m_rationals.push_back(m_chunk.IsRational(i) ? 1 : 0);
+        header.nbWeights += m_chunk.IsRational(i) ? m_chunk.Degree(i) + 1 : 0;
+    }
+
+    m_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_stream.write(reinterpret_cast<const char*>(m_chunk.Poles()), static_cast<std::streamsize>(header.nbPoles * sizeof(gp_Pnt)));
+    for (const Geom_BezierCurveView curve : m_chunk)
+    {
+        if (curve.IsRational())
+        {
+            m_stream.write(reinterpret_cast<const char*>(curve.Weights()), static_cast<std::streamsize>(curve.NbPoles() * sizeof(double)));
+        }
+    }
+    m_stream.write(reinterpret_cast<const char*>(m_degrees.data()), static_cast<std::streamsize>(m_degrees.size() * sizeof(int32_t)));
+    m_stream.write(reinterpret_cast<const char*>(m_rationals.data()), static_cast<std::streamsize>(m_rationals.size()));
+    VALIDATE_FILE(!m_stream, m_path, "IO_BezierCurveWriter: Cannot write the file!");
+
+    m_chunk.Clear();
+}
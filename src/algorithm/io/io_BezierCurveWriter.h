@@ -0,0 +1,70 @@
+// Writes Bezier curves one by one to a stream file, see IO_BezierCurveStream.
+// The curves are gathered in a chunk of at most ChunkSize() poles, written to the file when the next curve
+// does not fit, so that the memory of the writer does not grow with the number of curves.
+
+#ifndef IO_BEZIERCURVEWRITER_H
+#define IO_BEZIERCURVEWRITER_H
+
+#include "io_BezierCurveStream.h"
+#include "curve/geom_BezierCurveSet.h"
+
+#include <fstream>
+#include <string>
+
+class IO_BezierCurveWriter
+{
+public:
+    // Creates the stream file of the path, replacing it, written in chunks of at most chunkSize poles.
+    // Raised if chunkSize is lower than Geom_BezierCurve::MaxDegree() + 1, or if the file cannot be created.
+    IO_BezierCurveWriter(const std::string& path, const int chunkSize);
+
+    IO_BezierCurveWriter(const IO_BezierCurveWriter&) = delete;
+    IO_BezierCurveWriter& operator=(const IO_BezierCurveWriter&) = delete;
+
+    // Closes the file if Close() was not called, ignoring the errors.
+    ~IO_BezierCurveWriter();
+
+    // Writes the curve of the nbPoles poles and weights, null for a non-rational curve.
+    // Raised as Geom_BezierCurveSet::Append(), or if the file cannot be written or is closed.
+    void Write(const gp_Pnt* poles, const int nbPoles, const double* weights);
+
+    // Writes the curve.
+    void Write(const Geom_BezierCurve& curve);
+
+    // Writes the curve.
+    void Write(const Geom_BezierCurveView& curve);
+
+    // Writes all the curves of the set.
+    void Write(const Geom_BezierCurveSet& curves);
+
+    // Writes the last chunk and the end of the file, and closes it.
+    // Raised if the file cannot be written.
+    void Close();
+
+    // Returns the number of curves written.
+    inline long long NbCurves() const
+    {
+        return m_nbCurves;
+    }
+
+    // Returns the largest number of poles of a chunk.
+    inline int ChunkSize() const
+    {
+        return m_chunkSize;
+    }
+
+private:
+    // Writes the chunk to the file and empties it.
+    void Flush();
+
+private:
+    std::string m_path;
+    std::ofstream m_stream;
+    int m_chunkSize;
+    long long m_nbCurves;
+    Geom_BezierCurveSet m_chunk;
+    std::vector<int32_t> m_degrees;
+    std::vector<unsigned char> m_rationals;
+};
+
+#endif
@@ -0,0 +1,475 @@
+#include "mesh_SurfaceTessellator.h"
+#include "exceptions.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+#include <unordered_map>
+
+namespace
+{
+    // Number of samples of the derivatives of a patch in each direction.
+    constexpr int NbSamples = 9;
+
+    // Number of patches in a chunk of the parallel loops.
+    constexpr int Grain = 16;
+
+    // The sides of the parameter rectangle turn counterclockwise: the side k runs from the corner k
+    // to the corner k + 1, the corners being (u1, v1), (u2, v1), (u2, v2) and (u1, v2).
+    constexpr int NbSides = 4;
+
+    // A patch measured before the matching of its sides.
+    struct Patch
+    {
+        double u1, u2, v1, v2;
+        int nbU, nbV;
+        gp_Pnt corners[NbSides];
+        gp_Vec normals[NbSides];
+
+        // Points of the sides at 1/4 and 1/2, which tell the sides apart.
+        gp_Pnt quarters[NbSides];
+        gp_Pnt middles[NbSides];
+    };
+
+    // An edge, sampled by the side of the patch which created it.
+    struct Edge
+    {
+        int patch;
+        int side;
+        int first;
+        int last;
+        bool degenerate;
+        int nbSegments;
+        int firstNode;
+    };
+
+    // Returns the parameters of the point t in [0, 1] of the side k.
+    void SideParameters(const Patch& patch, const int k, const double t, double& u, double& v)
+    {
+        switch (k)
+        {
+        case 0:
+            u = patch.u1 + t * (patch.u2 - patch.u1);
+            v = patch.v1;
+            break;
+        case 1:
+            u = patch.u2;
+            v = patch.v1 + t * (patch.v2 - patch.v1);
+            break;
+        case 2:
+            u = patch.u2 + t * (patch.u1 - patch.u2);
+            v = patch.v2;
+            break;
+        default:
+            u = patch.u1;
+            v = patch.v2 + t * (patch.v1 - patch.v2);
+            break;
+        }
+    }
+
+    // Returns the unit normal at (u, v). Where the surface is degenerate, as at the apex of a cone,
+    // the normal is taken slightly toward the center of the patch; null if it is still degenerate.
+    gp_Vec Normal(const Geom_Surface& surface, const Patch& patch, const double u, const double v)
+    {
+        const double offsets[] = {0.0, 1.e-6, 1.e-3};
+        const double uc = 0.5 * (patch.u1 + patch.u2), vc = 0.5 * (patch.v1 + patch.v2);
+        for (const double offset : offsets)
+        {
+            gp_Pnt p;
+            gp_Vec d1u, d1v;
+            surface.D1(u + offset * (uc - u), v + offset * (vc - v), p, d1u, d1v);
+            const gp_Vec normal = glm::cross(d1u, d1v);
+            const double length = glm::length(normal);
+            if (length > gp_Resolution)
+            {
+                return normal / length;
+            }
+        }
+        return gp_Vec(0.0);
+    }
+
+    // Cell of the grid of step the weld tolerance.
+    struct Cell
+    {
+        long long x, y, z;
+
+        bool operator==(const Cell& other) const
+        {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+
+    struct CellHash
+    {
+        size_t operator()(const Cell& cell) const
+        {
+            return std::hash<long long>()(cell.x * 73856093LL ^ cell.y * 19349663LL ^ cell.z * 83492791LL);
+        }
+    };
+
+    // Welds the points closer than the tolerance into nodes: nodes[i] is the node of the point i, the nodes
+    // are numbered in the order of their first points, which are stored in firstPoints.
+    // The points of a node are at most the tolerance away from its first point.
+    void Weld(const gp_Pnt* points, const int nbPoints, const double tolerance, int* nodes, std_Array1OfInteger& firstPoints)
+    {
+        std::unordered_map<Cell, std::vector<int>, CellHash> cells;
+        cells.reserve(nbPoints);
+        firstPoints.clear();
+        for (int i = 0; i < nbPoints; ++i)
+        {
+            const gp_Pnt& p = points[i];
+            const Cell cell = {static_cast<long long>(std::floor(p.x / tolerance)),
+                               static_cast<long long>(std::floor(p.y / tolerance)),
+                               static_cast<long long>(std::floor(p.z / tolerance))};
+
+            // The first points within the tolerance are in the neighbouring cells.
+            int node = -1;
+            for (long long dx = -1; dx <= 1 && node < 0; ++dx)
+            {
+                for (long long dy = -1; dy <= 1 && node < 0; ++dy)
+                {
+                    for (long long dz = -1; dz <= 1 && node < 0; ++dz)
+                    {
+                        const auto found = cells.find({cell.x + dx, cell.y + dy, cell.z + dz});
+                        if (found == cells.end())
+                        {
+                            continue;
+                        }
+                        for (const int candidate : found->second)
+                        {
+                            if (glm::distance(points[firstPoints[candidate]], p) <= tolerance)
+                            {
+                                node = candidate;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (node < 0)
+            {
+                node = static_cast<int>(firstPoints.size());
+                firstPoints.push_back(i);
+                cells[cell].push_back(node);
+            }
+            nodes[i] = node;
+        }
+    }
+
+    // Joins the samples of a side, outer[0], ..., outer[m] at t = s / m, to the nodes of the grid along the side,
+    // inner[0], ..., inner[nbInner - 1] at t = (r + 1) / n, with triangles that follow the side. The triangles
+    // with two identical nodes, on a degenerate side, are skipped. Returns the number of triangles written.
+    int Zip(const int* outer, const int m, const int* inner, const int nbInner, const int n, Mesh_Triangle* triangles)
+    {
+        int nbTriangles = 0;
+        int s = 0, r = 0;
+        while (s < m || r < nbInner - 1)
+        {
+            // Advances on the side whose next node comes first.
+            if (r == nbInner - 1 || (s < m && (s + 1) * n <= (r + 2) * m))
+            {
+                if (outer[s] != outer[s + 1])
+                {
+                    triangles[nbTriangles++] = {outer[s], outer[s + 1], inner[r]};
+                }
+                ++s;
+            }
+            else
+            {
+                triangles[nbTriangles++] = {outer[s], inner[r + 1], inner[r]};
+                ++r;
+            }
+        }
+        return nbTriangles;
+    }
+}
+
+Mesh_SurfaceTessellator::Mesh_SurfaceTessellator(const double deflection, const double angle)
+    : m_deflection(deflection),
+      m_angle(angle)
+{
+    VALIDATE_ARGUMENT(deflection <= Precision::Confusion(), "deflection", "Mesh_SurfaceTessellator: Deflection is not greater than Confusion!");
+    VALIDATE_ARGUMENT(angle <= 0.0 || angle > glm::pi<double>(), "angle", "Mesh_SurfaceTessellator: Angle is not in ]0, Pi]!");
+}
+
+void Mesh_SurfaceTessellator::NbSegments(const Geom_Surface& surface, int& nbU, int& nbV) const
+{
+    double u1, u2, v1, v2;
+    surface.Bounds(u1, u2, v1, v2);
+
+    double maxUU = 0.0, maxVV = 0.0, maxUV = 0.0, rateU = 0.0, rateV = 0.0;
+    for (int i = 0; i < NbSamples; ++i)
+    {
+        const double u = u1 + (u2 - u1) * i / (NbSamples - 1);
+        for (int j = 0; j < NbSamples; ++j)
+        {
+            const double v = v1 + (v2 - v1) * j / (NbSamples - 1);
+            gp_Pnt p;
+            gp_Vec d1u, d1v, d2u, d2v, d2uv;
+            surface.D2(u, v, p, d1u, d1v, d2u, d2v, d2uv);
+
+            const double lengthUU = glm::length(d2u), lengthVV = glm::length(d2v);
+            maxUU = std::max(maxUU, lengthUU);
+            maxVV = std::max(maxVV, lengthVV);
+            maxUV = std::max(maxUV, glm::length(d2uv));
+
+            // The turn of the tangents, then of the normals; degenerate points don't bound the rates.
+            const double lengthU = glm::length(d1u), lengthV = glm::length(d1v);
+            if (lengthU > gp_Resolution)
+            {
+                rateU = std::max(rateU, lengthUU / lengthU);
+            }
+            if (lengthV > gp_Resolution)
+            {
+                rateV = std::max(rateV, lengthVV / lengthV);
+            }
+            const double area = glm::length(glm::cross(d1u, d1v));
+            if (area > gp_Resolution)
+            {
+                rateU = std::max(rateU, (glm::length(glm::cross(d2u, d1v)) + glm::length(glm::cross(d1u, d2uv))) / area);
+                rateV = std::max(rateV, (glm::length(glm::cross(d2uv, d1v)) + glm::length(glm::cross(d1u, d2v))) / area);
+            }
+        }
+    }
+
+    auto count = [this](const double range, const double second, const double rate)
+    {
+        const double n = std::max(range * std::sqrt(second / (4.0 * m_deflection)), range * rate / (0.5 * m_angle));
+        return static_cast<int>(std::min(std::max(std::ceil(n), 2.0), static_cast<double>(MaxNbSegments())));
+    };
+    nbU = count(u2 - u1, maxUU + maxUV, rateU);
+    nbV = count(v2 - v1, maxVV + maxUV, rateV);
+}
+
+Mesh_Triangulation Mesh_SurfaceTessellator::Perform(const handle<Geom_Surface>* patches, const int nbPatches) const
+{
+    VALIDATE_ARGUMENT(nbPatches < 0, "nbPatches", "Mesh_SurfaceTessellator: Number of patches is negative!");
+
+    const double tolerance = Precision::Confusion();
+    const int nbSides = NbSides * nbPatches;
+
+    // Measure the patches
+    std::vector<Patch> measures(nbPatches);
+    Parallel::For(nbPatches, Grain, [&](const int first, const int last)
+    {
+        for (int i = first; i < last; ++i)
+        {
+            const Geom_Surface& surface = *patches[i];
+            Patch& patch = measures[i];
+            surface.Bounds(patch.u1, patch.u2, patch.v1, patch.v2);
+            NbSegments(surface, patch.nbU, patch.nbV);
+            for (int k = 0; k < NbSides; ++k)
+            {
+                double u, v;
+                SideParameters(patch, k, 0.0, u, v);
+                surface.D0(u, v, patch.corners[k]);
+                patch.normals[k] = Normal(surface, patch, u, v);
+                SideParameters(patch, k, 0.25, u, v);
+                surface.D0(u, v, patch.quarters[k]);
+                SideParameters(patch, k, 0.5, u, v);
+                surface.D0(u, v, patch.middles[k]);
+            }
+        }
+    });
+
+    // Weld the corners
+    gp_Array1OfPnt corners(nbSides);
+    for (int i = 0; i < nbSides; ++i)
+    {
+        corners[i] = measures[i / NbSides].corners[i % NbSides];
+    }
+    std_Array1OfInteger cornerNodes(nbSides), firstCorners;
+    Weld(corners.data(), nbSides, tolerance, cornerNodes.data(), firstCorners);
+
+    // Match the sides into edges: the sides between the same nodes with the same midpoint
+    std::vector<Edge> edges;
+    std_Array1OfInteger sideEdges(nbSides);
+    std::vector<bool> reversed(nbSides, false);
+    std::unordered_map<long long, std_Array1OfInteger> nodeEdges;
+    for (int i = 0; i < nbSides; ++i)
+    {
+        const Patch& patch = measures[i / NbSides];
+        const int k = i % NbSides;
+        const int first = cornerNodes[i];
+        const int last = cornerNodes[(i / NbSides) * NbSides + (k + 1) % NbSides];
+        const long long key = static_cast<long long>(std::min(first, last)) * nbSides + std::max(first, last);
+
+        std_Array1OfInteger& candidates = nodeEdges[key];
+        int edge = -1;
+        for (const int candidate : candidates)
+        {
+            const Edge& other = edges[candidate];
+            if (glm::distance(measures[other.patch].middles[other.side], patch.middles[k]) <= tolerance)
+            {
+                edge = candidate;
+                break;
+            }
+        }
+
+        const bool degenerate = first == last && glm::distance(patch.middles[k], patch.corners[k]) <= tolerance
+                                && glm::distance(patch.quarters[k], patch.corners[k]) <= tolerance;
+        const int nbSegments = degenerate ? 1 : (k % 2 == 0 ? patch.nbU : patch.nbV);
+        if (edge < 0)
+        {
+            edge = static_cast<int>(edges.size());
+            edges.push_back({i / NbSides, k, first, last, degenerate, nbSegments, 0});
+            candidates.push_back(edge);
+        }
+        else
+        {
+            // The edge is sampled with the finest steps, a closed edge has its direction from its first quarter.
+            Edge& other = edges[edge];
+            other.nbSegments = other.degenerate ? 1 : std::max(other.nbSegments, nbSegments);
+            reversed[i] = first != other.first
+                          || (first == last && glm::distance(measures[other.patch].quarters[other.side], patch.quarters[k]) > tolerance);
+        }
+        sideEdges[i] = edge;
+    }
+
+    // Number the nodes: the corners, the samples inside the edges, then the grids inside the patches
+    int nbNodes = static_cast<int>(firstCorners.size());
+    for (Edge& edge : edges)
+    {
+        edge.firstNode = nbNodes;
+        nbNodes += edge.nbSegments - 1;
+    }
+    std_Array1OfInteger patchNodes(nbPatches);
+    for (int i = 0; i < nbPatches; ++i)
+    {
+        patchNodes[i] = nbNodes;
+        nbNodes += (measures[i].nbU - 1) * (measures[i].nbV - 1);
+    }
+
+    // Count the triangles: two per cell of the grid, and per side one per segment of the edge and of the grid
+    Mesh_Triangulation triangulation;
+    triangulation.patchTriangles.resize(nbPatches + 1);
+    triangulation.patchTriangles[0] = 0;
+    for (int i = 0; i < nbPatches; ++i)
+    {
+        const Patch& patch = measures[i];
+        int nbTriangles = 2 * (patch.nbU - 2) * (patch.nbV - 2);
+        for (int k = 0; k < NbSides; ++k)
+        {
+            const Edge& edge = edges[sideEdges[i * NbSides + k]];
+            nbTriangles += edge.nbSegments + (k % 2 == 0 ? patch.nbU : patch.nbV) - 2 - (edge.degenerate ? 1 : 0);
+        }
+        triangulation.patchTriangles[i + 1] = triangulation.patchTriangles[i] + nbTriangles;
+    }
+
+    triangulation.nodes.resize(nbNodes);
+    triangulation.normals.resize(nbNodes);
+    triangulation.triangles.resize(triangulation.patchTriangles[nbPatches]);
+    for (int node = 0; node < static_cast<int>(firstCorners.size()); ++node)
+    {
+        const int i = firstCorners[node];
+        triangulation.nodes[node] = corners[i];
+        triangulation.normals[node] = measures[i / NbSides].normals[i % NbSides];
+    }
+
+    // Mesh the patches, each in its own ranges of the buffers
+    Parallel::For(nbPatches, Grain, [&](const int first, const int last)
+    {
+        std_Array1OfReal params, buffer;
+        std_Array1OfInteger outer, inner;
+        for (int i = first; i < last; ++i)
+        {
+            const Geom_Surface& surface = *patches[i];
+            const Patch& patch = measures[i];
+            const int nbU = patch.nbU, nbV = patch.nbV;
+
+            // Samples of the edges created by the patch
+            for (int k = 0; k < NbSides; ++k)
+            {
+                const Edge& edge = edges[sideEdges[i * NbSides + k]];
+                if (edge.patch != i || edge.side != k)
+                {
+                    continue;
+                }
+                for (int s = 1; s < edge.nbSegments; ++s)
+                {
+                    double u, v;
+                    SideParameters(patch, k, static_cast<double>(s) / edge.nbSegments, u, v);
+                    surface.D0(u, v, triangulation.nodes[edge.firstNode + s - 1]);
+                    triangulation.normals[edge.firstNode + s - 1] = Normal(surface, patch, u, v);
+                }
+            }
+
+            // Nodes of the grid inside the patch, the node (a, b) for a in [1, nbU - 1] and b in [1, nbV - 1]
+            // is the node patchNodes[i] + (a - 1) * (nbV - 1) + b - 1.
+            const int nbInnerU = nbU - 1, nbInnerV = nbV - 1, nbInner = nbInnerU * nbInnerV;
+            params.resize(nbInnerU + nbInnerV);
+            for (int a = 1; a < nbU; ++a)
+            {
+                params[a - 1] = patch.u1 + (patch.u2 - patch.u1) * a / nbU;
+            }
+            for (int b = 1; b < nbV; ++b)
+            {
+                params[nbInnerU + b - 1] = patch.v1 + (patch.v2 - patch.v1) * b / nbV;
+            }
+            buffer.resize(6 * nbInner);
+            const gp_SoAOfXYZ p = {buffer.data(), buffer.data() + nbInner, buffer.data() + 2 * nbInner};
+            const gp_SoAOfXYZ n = {buffer.data() + 3 * nbInner, buffer.data() + 4 * nbInner, buffer.data() + 5 * nbInner};
+            surface.NormalGrid(params.data(), nbInnerU, params.data() + nbInnerU, nbInnerV, p, n);
+            for (int g = 0; g < nbInner; ++g)
+            {
+                triangulation.nodes[patchNodes[i] + g] = p.Value(g);
+                triangulation.normals[patchNodes[i] + g] = n.Value(g);
+            }
+            auto node = [&](const int a, const int b)
+            {
+                return patchNodes[i] + (a - 1) * nbInnerV + b - 1;
+            };
+
+            // Triangles of the cells of the grid, counterclockwise in the parameters
+            Mesh_Triangle* triangles = triangulation.triangles.data() + triangulation.patchTriangles[i];
+            for (int a = 1; a < nbU - 1; ++a)
+            {
+                for (int b = 1; b < nbV - 1; ++b)
+                {
+                    *triangles++ = {node(a, b), node(a + 1, b), node(a + 1, b + 1)};
+                    *triangles++ = {node(a, b), node(a + 1, b + 1), node(a, b + 1)};
+                }
+            }
+
+            // Triangles joining the samples of each side to the grid, the grid being on the left of the side
+            for (int k = 0; k < NbSides; ++k)
+            {
+                const Edge& edge = edges[sideEdges[i * NbSides + k]];
+                const int m = edge.nbSegments;
+                outer.resize(m + 1);
+                outer[0] = cornerNodes[i * NbSides + k];
+                outer[m] = cornerNodes[i * NbSides + (k + 1) % NbSides];
+                for (int s = 1; s < m; ++s)
+                {
+                    outer[s] = edge.firstNode + (reversed[i * NbSides + k] ? m - s : s) - 1;
+                }
+
+                const int nbSegments = k % 2 == 0 ? nbU : nbV;
+                inner.resize(nbSegments - 1);
+                for (int r = 0; r < nbSegments - 1; ++r)
+                {
+                    switch (k)
+                    {
+                    case 0:
+                        inner[r] = node(r + 1, 1);
+                        break;
+                    case 1:
+                        inner[r] = node(nbU - 1, r + 1);
+                        break;
+                    case 2:
+                        inner[r] = node(nbU - 1 - r, nbV - 1);
+                        break;
+                    default:
+                        inner[r] = node(1, nbV - 1 - r);
+                        break;
+                    }
+                }
+                triangles += Zip(outer.data(), m, inner.data(), nbSegments - 1, nbSegments, triangles);
+            }
+        }
+    });
+
+    return triangulation;
+}
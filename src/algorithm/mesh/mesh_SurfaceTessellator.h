@@ -0,0 +1,61 @@
+// Tessellates a set of surface patches into one watertight indexed triangulation.
+// Each patch is meshed on a grid of its parameter rectangle whose steps in u and v bound the chordal deviation
+// and the angle between the normals of neighbouring nodes. The boundaries of the patches are matched into edges:
+// the corners closer than Confusion are welded and two sides between the same corners with the same midpoint
+// are one edge, which is sampled once with the steps of the finest of its patches. The patches reference the
+// nodes of their edges, so that the triangulation has no crack, and each grid is joined to the samples of its
+// sides by a strip of triangles. Shared sides must have the same parameterization, possibly reversed, as the
+// boundaries of Bezier patches on the same row of poles.
+// The patches are measured and meshed in parallel, each in its own ranges of the node and triangle buffers.
+
+#ifndef MESH_SURFACETESSELLATOR_H
+#define MESH_SURFACETESSELLATOR_H
+
+#include "mesh_Triangulation.h"
+#include "surface/geom_Surface.h"
+
+class Mesh_SurfaceTessellator
+{
+public:
+    // Creates a tessellator of the chordal deflection, the largest distance between a triangle and its surface,
+    // and of the angular deflection in radians, the largest angle between the normals of two neighbouring nodes.
+    // Raised if deflection is not greater than Confusion or if angle is not in ]0, Pi].
+    Mesh_SurfaceTessellator(const double deflection, const double angle);
+
+    // Tessellates the nbPatches patches into one triangulation, the triangles of the patch i being
+    // in the range i of the triangulation.
+    // The deviations are bounded from the derivatives sampled on a grid of each patch.
+    Mesh_Triangulation Perform(const handle<Geom_Surface>* patches, const int nbPatches) const;
+
+    // Returns the chordal deflection.
+    inline double Deflection() const
+    {
+        return m_deflection;
+    }
+
+    // Returns the angular deflection.
+    inline double Angle() const
+    {
+        return m_angle;
+    }
+
+    // Returns the largest number of segments of a patch in each direction. This value is 1024.
+    constexpr static int MaxNbSegments()
+    {
+        return 1024;
+    }
+
+private:
+    // Returns the numbers of segments nbU and nbV, at least 2, of the grid of the surface from the bounds of its
+    // derivatives sampled on a grid. A cell of steps hu and hv deviates by at most
+    // (hu^2 (|Suu| + |Suv|) + hv^2 (|Svv| + |Suv|)) / 8, of which each direction takes half of the deflection,
+    // and a step hu turns the tangent and the normal by at most hu |Suu| / |Su| and hu (|Suu x Sv| + |Su x Suv|) / |Su x Sv|,
+    // likewise in v, of which each direction takes half of the angle so that the diagonals of the cells are bounded too.
+    void NbSegments(const Geom_Surface& surface, int& nbU, int& nbV) const;
+
+private:
+    double m_deflection;
+    double m_angle;
+};
+
+#endif
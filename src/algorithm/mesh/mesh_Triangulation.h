@@ -0,0 +1,40 @@
+// Describes an indexed triangle mesh
+// - the nodes are shared by the triangles which reference them by index,
+// - each node has a unit normal, null where the surface is degenerate,
+// - the triangles of each patch of the tessellated surfaces are consecutive.
+// The triangles are oriented counterclockwise around the normals of their surfaces.
+
+#ifndef MESH_TRIANGULATION_H
+#define MESH_TRIANGULATION_H
+
+#include "geometry.h"
+#include "utils.h"
+
+#include <array>
+
+// Defines a triangle by the indices of its three nodes.
+using Mesh_Triangle = std::array<int, 3>;
+
+struct Mesh_Triangulation
+{
+    gp_Array1OfPnt nodes;
+    std::vector<gp_Vec> normals;
+    std::vector<Mesh_Triangle> triangles;
+
+    // The triangles of the patch i are in [patchTriangles[i], patchTriangles[i + 1][.
+    std_Array1OfInteger patchTriangles;
+
+    // Returns the number of nodes.
+    inline int NbNodes() const
+    {
+        return static_cast<int>(nodes.size());
+    }
+
+    // Returns the number of triangles.
+    inline int NbTriangles() const
+    {
+        return static_cast<int>(triangles.size());
+    }
+};
+
+#endif
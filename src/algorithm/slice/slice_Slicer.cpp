@@ -0,0 +1,430 @@
+#include "slice_Slicer.h"
+#include "mesh/mesh_SurfaceTessellator.h"
+#include "exceptions.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+namespace
+{
+    // Number of patches or curves in a chunk of the parallel loops.
+    constexpr int Grain = 16;
+
+    // Number of layers in a chunk of the parallel assembly.
+    constexpr int LayerGrain = 4;
+
+    // Largest number of iterations of the refinement of a root.
+    constexpr int MaxNbIterations = 64;
+
+    // The key of the edge between the nodes a and b.
+    inline unsigned long long EdgeKey(const int a, const int b)
+    {
+        return (static_cast<unsigned long long>(std::min(a, b)) << 32) | static_cast<unsigned int>(std::max(a, b));
+    }
+
+    // A segment of a layer, from the point on the edge from to the point on the edge to.
+    struct Segment
+    {
+        int layer;
+        unsigned long long from;
+        unsigned long long to;
+    };
+
+    // A crossing of a curve with a plane.
+    struct Crossing
+    {
+        int layer;
+        int curve;
+        double parameter;
+        gp_Pnt point;
+    };
+
+    // Returns the value at s of the polynomial of the Bernstein coefficients c[0], ..., c[degree].
+    double Casteljau(const double* c, const int degree, const double s)
+    {
+        double q[Geom_BezierKernel::MaxNbPoles];
+        std::copy(c, c + degree + 1, q);
+        for (int r = degree; r > 0; --r)
+        {
+            for (int j = 0; j < r; ++j)
+            {
+                q[j] = (1.0 - s) * q[j] + s * q[j + 1];
+            }
+        }
+        return q[0];
+    }
+
+    // Appends to roots the parameters in [t1, t2] where the polynomial of the Bernstein coefficients c[0], ..., c[degree]
+    // on [t1, t2] becomes negative or non-negative, in increasing order. The intervals whose coefficients change sign
+    // more than once are halved, the number of sign changes bounding the number of roots; a single change is refined
+    // by the Illinois variant of the regula falsi. A zero counts as non-negative, as the nodes on the planes are above.
+    void Roots(const double* c, const int degree, const double t1, const double t2, std_Array1OfReal& roots)
+    {
+        int changes = 0;
+        for (int j = 0; j < degree; ++j)
+        {
+            changes += (c[j] >= 0.0) != (c[j + 1] >= 0.0) ? 1 : 0;
+        }
+        if (changes == 0)
+        {
+            return;
+        }
+
+        if (changes == 1)
+        {
+            double a = 0.0, b = 1.0, fa = c[0], fb = c[degree], s = 0.5;
+            int side = 0;
+            for (int i = 0; i < MaxNbIterations && (b - a) * (t2 - t1) > Precision::PConfusion() * 1.e-3; ++i)
+            {
+                s = std::min(std::max((a * fb - b * fa) / (fb - fa), a), b);
+                const double fs = Casteljau(c, degree, s);
+                if (fs == 0.0)
+                {
+                    break;
+                }
+                if ((fs >= 0.0) == (fa >= 0.0))
+                {
+                    a = s;
+                    fa = fs;
+                    fb = side == -1 ? 0.5 * fb : fb;
+                    side = -1;
+                }
+                else
+                {
+                    b = s;
+                    fb = fs;
+                    fa = side == 1 ? 0.5 * fa : fa;
+                    side = 1;
+                }
+            }
+            roots.push_back(t1 + s * (t2 - t1));
+            return;
+        }
+
+        if (t2 - t1 <= Precision::PConfusion())
+        {
+            // Clustered roots: an odd number of changes still crosses the plane.
+            if (changes % 2 == 1)
+            {
+                roots.push_back(0.5 * (t1 + t2));
+            }
+            return;
+        }
+
+        // The first coefficients of the levels are the left half, the last ones the right half.
+        double left[Geom_BezierKernel::MaxNbPoles], right[Geom_BezierKernel::MaxNbPoles];
+        std::copy(c, c + degree + 1, right);
+        left[0] = right[0];
+        for (int r = 1; r <= degree; ++r)
+        {
+            for (int j = 0; j <= degree - r; ++j)
+            {
+                right[j] = 0.5 * (right[j] + right[j + 1]);
+            }
+            left[r] = right[0];
+        }
+        const double middle = 0.5 * (t1 + t2);
+        Roots(left, degree, t1, middle, roots);
+        Roots(right, degree, middle, t2, roots);
+    }
+}
+
+Slice_Slicer::Slice_Slicer(const gp_Vec& direction, const double* heights, const int nbHeights)
+{
+    VALIDATE_ARGUMENT(glm::length(direction) <= gp_Resolution, "direction", "Slice_Slicer: Direction is null!");
+    VALIDATE_ARGUMENT(nbHeights < 1, "nbHeights", "Slice_Slicer: Number of heights is lower than 1!");
+    for (int k = 1; k < nbHeights; ++k)
+    {
+        VALIDATE_ARGUMENT(heights[k] <= heights[k - 1], "heights", "Slice_Slicer: Heights are not increasing!");
+    }
+
+    m_direction = glm::normalize(direction);
+    m_heights.assign(heights, heights + nbHeights);
+}
+
+Slice_Slicer Slice_Slicer::Uniform(const gp_Vec& direction, const double first, const double step, const int nbPlanes)
+{
+    VALIDATE_ARGUMENT(step <= 0.0, "step", "Slice_Slicer: Step is not positive!");
+    VALIDATE_ARGUMENT(nbPlanes < 1, "nbPlanes", "Slice_Slicer: Number of planes is lower than 1!");
+
+    std_Array1OfReal heights(nbPlanes);
+    for (int k = 0; k < nbPlanes; ++k)
+    {
+        heights[k] = first + k * step;
+    }
+    return Slice_Slicer(direction, heights.data(), nbPlanes);
+}
+
+std::vector<Slice_Layer> Slice_Slicer::SliceMesh(const Mesh_Triangulation& mesh) const
+{
+    const int nbPlanes = NbPlanes();
+    std::vector<Slice_Layer> layers(nbPlanes);
+    for (int k = 0; k < nbPlanes; ++k)
+    {
+        layers[k].height = m_heights[k];
+    }
+
+    // Heights of the nodes, and ranges of the triangles of the patches, one patch if the triangulation has none
+    std_Array1OfReal heights(mesh.NbNodes());
+    Parallel::For(mesh.NbNodes(), 1 << 12, [&](const int first, const int last)
+    {
+        for (int i = first; i < last; ++i)
+        {
+            heights[i] = glm::dot(m_direction, mesh.nodes[i]);
+        }
+    });
+    std_Array1OfInteger bounds = mesh.patchTriangles;
+    if (bounds.empty())
+    {
+        bounds = {0, mesh.NbTriangles()};
+    }
+    const int nbPatches = static_cast<int>(bounds.size()) - 1;
+
+    // Sort the patches by their lowest height
+    std_Array1OfReal lows(nbPatches, std::numeric_limits<double>::infinity());
+    std_Array1OfReal highs(nbPatches, -std::numeric_limits<double>::infinity());
+    Parallel::For(nbPatches, Grain, [&](const int first, const int last)
+    {
+        for (int i = first; i < last; ++i)
+        {
+            for (int t = bounds[i]; t < bounds[i + 1]; ++t)
+            {
+                for (const int node : mesh.triangles[t])
+                {
+                    lows[i] = std::min(lows[i], heights[node]);
+                    highs[i] = std::max(highs[i], heights[node]);
+                }
+            }
+        }
+    });
+    std_Array1OfInteger order(nbPatches);
+    for (int i = 0; i < nbPatches; ++i)
+    {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&lows](const int a, const int b)
+    {
+        return lows[a] < lows[b];
+    });
+
+    // Cut the triangles of the patches by the planes of their ranges, in chunks of patches
+    const int nbChunks = (nbPatches + Grain - 1) / Grain;
+    std::vector<std::vector<Segment>> chunks(nbChunks);
+    Parallel::For(nbPatches, Grain, [&](const int first, const int last)
+    {
+        std::vector<Segment>& segments = chunks[first / Grain];
+
+        // The first plane above the patches sweeps upward with their lowest heights.
+        int plane = static_cast<int>(std::upper_bound(m_heights.begin(), m_heights.end(), lows[order[first]]) - m_heights.begin());
+        for (int i = first; i < last; ++i)
+        {
+            const int patch = order[i];
+            while (plane < nbPlanes && m_heights[plane] <= lows[patch])
+            {
+                ++plane;
+            }
+            const int end = static_cast<int>(std::upper_bound(m_heights.begin() + plane, m_heights.end(), highs[patch]) - m_heights.begin());
+            if (plane == end)
+            {
+                continue;
+            }
+
+            for (int t = bounds[patch]; t < bounds[patch + 1]; ++t)
+            {
+                const Mesh_Triangle& triangle = mesh.triangles[t];
+                const double z[3] = {heights[triangle[0]], heights[triangle[1]], heights[triangle[2]]};
+                const double low = std::min(std::min(z[0], z[1]), z[2]);
+                const double high = std::max(std::max(z[0], z[1]), z[2]);
+                int k = static_cast<int>(std::upper_bound(m_heights.begin() + plane, m_heights.begin() + end, low) - m_heights.begin());
+                for (; k < end && m_heights[k] <= high; ++k)
+                {
+                    // The segment runs from the edge going down to the edge going up, in the order of the nodes.
+                    Segment segment = {k, 0, 0};
+                    for (int e = 0; e < 3; ++e)
+                    {
+                        const bool above = z[e] >= m_heights[k];
+                        const bool nextAbove = z[(e + 1) % 3] >= m_heights[k];
+                        if (above && !nextAbove)
+                        {
+                            segment.from = EdgeKey(triangle[e], triangle[(e + 1) % 3]);
+                        }
+                        else if (!above && nextAbove)
+                        {
+                            segment.to = EdgeKey(triangle[e], triangle[(e + 1) % 3]);
+                        }
+                    }
+                    segments.push_back(segment);
+                }
+            }
+        }
+    });
+
+    // Gather the segments by layer
+    std_Array1OfInteger offsets(nbPlanes + 1, 0);
+    for (const std::vector<Segment>& segments : chunks)
+    {
+        for (const Segment& segment : segments)
+        {
+            ++offsets[segment.layer + 1];
+        }
+    }
+    for (int k = 0; k < nbPlanes; ++k)
+    {
+        offsets[k + 1] += offsets[k];
+    }
+    std::vector<std::pair<unsigned long long, unsigned long long>> sorted(offsets[nbPlanes]);
+    std_Array1OfInteger next(offsets.begin(), offsets.end() - 1);
+    for (std::vector<Segment>& segments : chunks)
+    {
+        for (const Segment& segment : segments)
+        {
+            sorted[next[segment.layer]++] = {segment.from, segment.to};
+        }
+        std::vector<Segment>().swap(segments);
+    }
+
+    // Chain the segments of each layer into contours: the open ones from their first segment, then the closed ones
+    Parallel::For(nbPlanes, LayerGrain, [&](const int first, const int last)
+    {
+        std::unordered_map<unsigned long long, int> starts;
+        std::vector<bool> visited, continued;
+        for (int k = first; k < last; ++k)
+        {
+            Slice_Layer& layer = layers[k];
+            const int firstSegment = offsets[k], nbSegments = offsets[k + 1] - offsets[k];
+            if (nbSegments == 0)
+            {
+                continue;
+            }
+
+            // The segments which continue another one cannot start an open contour.
+            starts.clear();
+            starts.reserve(nbSegments);
+            for (int s = 0; s < nbSegments; ++s)
+            {
+                starts.emplace(sorted[firstSegment + s].first, s);
+            }
+            continued.assign(nbSegments, false);
+            for (int s = 0; s < nbSegments; ++s)
+            {
+                const auto found = starts.find(sorted[firstSegment + s].second);
+                if (found != starts.end())
+                {
+                    continued[found->second] = true;
+                }
+            }
+
+            auto point = [&](const unsigned long long key)
+            {
+                const int a = static_cast<int>(key >> 32), b = static_cast<int>(key & 0xffffffffULL);
+                const double t = (layer.height - heights[a]) / (heights[b] - heights[a]);
+                return mesh.nodes[a] + t * (mesh.nodes[b] - mesh.nodes[a]);
+            };
+            auto chain = [&](int s)
+            {
+                layer.contours.push_back(static_cast<int>(layer.points.size()));
+                layer.points.push_back(point(sorted[firstSegment + s].first));
+                while (!visited[s])
+                {
+                    visited[s] = true;
+                    layer.points.push_back(point(sorted[firstSegment + s].second));
+                    const auto found = starts.find(sorted[firstSegment + s].second);
+                    if (found == starts.end())
+                    {
+                        break;
+                    }
+                    s = found->second;
+                }
+            };
+
+            visited.assign(nbSegments, false);
+            layer.points.reserve(nbSegments + 1);
+            for (int s = 0; s < nbSegments; ++s)
+            {
+                if (!visited[s] && !continued[s])
+                {
+                    chain(s);
+                }
+            }
+            for (int s = 0; s < nbSegments; ++s)
+            {
+                if (!visited[s])
+                {
+                    chain(s);
+                }
+            }
+            layer.contours.push_back(static_cast<int>(layer.points.size()));
+        }
+    });
+
+    return layers;
+}
+
+std::vector<Slice_Layer> Slice_Slicer::SlicePatches(const handle<Geom_Surface>* patches, const int nbPatches,
+                                                    const double deflection, const double angle) const
+{
+    const Mesh_SurfaceTessellator tessellator(deflection, angle);
+    return SliceMesh(tessellator.Perform(patches, nbPatches));
+}
+
+void Slice_Slicer::SliceCurves(const handle<Geom_BezierCurve>* curves, const int nbCurves, std::vector<Slice_Layer>& layers) const
+{
+    VALIDATE_ARGUMENT(static_cast<int>(layers.size()) != NbPlanes(), "layers", "Slice_Slicer: Layers don't match the planes!");
+
+    // Cross the curves with the planes of their ranges, in chunks of curves
+    const int nbChunks = (nbCurves + Grain - 1) / Grain;
+    std::vector<std::vector<Crossing>> chunks(nbChunks);
+    Parallel::For(nbCurves, Grain, [&](const int first, const int last)
+    {
+        std::vector<Crossing>& crossings = chunks[first / Grain];
+        std_Array1OfReal roots;
+        double heights[Geom_BezierKernel::MaxNbPoles], weights[Geom_BezierKernel::MaxNbPoles], c[Geom_BezierKernel::MaxNbPoles];
+        for (int i = first; i < last; ++i)
+        {
+            const Geom_BezierCurve& curve = *curves[i];
+            const int degree = curve.Degree();
+
+            // The heights of the poles bound the heights of the curve.
+            double low = std::numeric_limits<double>::infinity(), high = -low;
+            for (int j = 0; j <= degree; ++j)
+            {
+                weights[j] = curve.Weight(j);
+                heights[j] = glm::dot(m_direction, curve.Pole(j));
+                low = std::min(low, heights[j]);
+                high = std::max(high, heights[j]);
+            }
+            const int firstPlane = static_cast<int>(std::lower_bound(m_heights.begin(), m_heights.end(), low) - m_heights.begin());
+            const int lastPlane = static_cast<int>(std::upper_bound(m_heights.begin() + firstPlane, m_heights.end(), high) - m_heights.begin());
+
+            // The height of the homogeneous curve minus the height of the plane times the weight has the same roots.
+            for (int k = firstPlane; k < lastPlane; ++k)
+            {
+                for (int j = 0; j <= degree; ++j)
+                {
+                    c[j] = weights[j] * (heights[j] - m_heights[k]);
+                }
+                roots.clear();
+                Roots(c, degree, curve.FirstParameter(), curve.LastParameter(), roots);
+                for (const double u : roots)
+                {
+                    gp_Pnt p;
+                    curve.D0(u, p);
+                    crossings.push_back({k, i, u, p});
+                }
+            }
+        }
+    });
+
+    for (const std::vector<Crossing>& crossings : chunks)
+    {
+        for (const Crossing& crossing : crossings)
+        {
+            Slice_Layer& layer = layers[crossing.layer];
+            layer.crossings.push_back(crossing.point);
+            layer.crossingCurves.push_back(crossing.curve);
+            layer.crossingParameters.push_back(crossing.parameter);
+        }
+    }
+}
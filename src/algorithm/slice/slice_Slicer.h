@@ -0,0 +1,86 @@
+// Slices surfaces and curves with a family of parallel planes, for layer-based manufacturing.
+// The plane k holds the points p with Direction() . p = Heights()[k]. The surfaces are sliced through their
+// watertight triangulation: a node is above a plane if its height is not lower than the plane, so that each
+// triangle crossing a plane has exactly two edges with a node on each side and gives one segment between them.
+// The points of the segments are keyed by the edges of the triangulation, which the triangles share, and the
+// segments are chained into contours by their keys with no tolerance. The segments turn counterclockwise around
+// the direction when the triangles are oriented outward, so that the outer contours of a solid are counterclockwise.
+// The patches are sorted by their lowest height and each one is swept against the planes of its range only;
+// the contours of the layers are then assembled in parallel.
+
+#ifndef SLICE_SLICER_H
+#define SLICE_SLICER_H
+
+#include "mesh/mesh_Triangulation.h"
+#include "curve/geom_BezierCurve.h"
+#include "surface/geom_Surface.h"
+
+// The section of the model by a plane: the contours of the surfaces and the crossings of the curves.
+struct Slice_Layer
+{
+    double height;
+
+    // The contour c is the polyline of the points [contours[c], contours[c + 1][, a closed contour ends on its first point.
+    gp_Array1OfPnt points;
+    std_Array1OfInteger contours;
+
+    // The curve crossingCurves[i] crosses the plane at the point crossings[i], of parameter crossingParameters[i].
+    gp_Array1OfPnt crossings;
+    std_Array1OfInteger crossingCurves;
+    std_Array1OfReal crossingParameters;
+
+    // Returns the number of contours.
+    inline int NbContours() const
+    {
+        return contours.empty() ? 0 : static_cast<int>(contours.size()) - 1;
+    }
+};
+
+class Slice_Slicer
+{
+public:
+    // Creates the slicer of the planes of normal direction at the nbHeights heights.
+    // Raised if direction is null, if nbHeights is lower than 1 or if the heights are not increasing.
+    Slice_Slicer(const gp_Vec& direction, const double* heights, const int nbHeights);
+
+    // Returns the slicer of the nbPlanes planes of normal direction at the heights first, first + step, ...
+    // Raised as above, or if step is not positive.
+    static Slice_Slicer Uniform(const gp_Vec& direction, const double first, const double step, const int nbPlanes);
+
+    // Slices the triangulation into one layer per plane, the contours of its patches.
+    std::vector<Slice_Layer> SliceMesh(const Mesh_Triangulation& mesh) const;
+
+    // Slices the patches into one layer per plane, through their triangulation within the chordal deflection
+    // and the angle, see Mesh_SurfaceTessellator.
+    std::vector<Slice_Layer> SlicePatches(const handle<Geom_Surface>* patches, const int nbPatches,
+                                          const double deflection, const double angle) const;
+
+    // Adds to the layers, one per plane, the crossings of the curves with the planes. The roots of the height
+    // of each curve are isolated by subdivision of its poles in the Bernstein basis, on the planes of its range only.
+    // Raised if layers does not hold one layer per plane.
+    void SliceCurves(const handle<Geom_BezierCurve>* curves, const int nbCurves, std::vector<Slice_Layer>& layers) const;
+
+    // Returns the unit normal of the planes.
+    inline const gp_Vec& Direction() const
+    {
+        return m_direction;
+    }
+
+    // Returns the heights of the planes.
+    inline const std_Array1OfReal& Heights() const
+    {
+        return m_heights;
+    }
+
+    // Returns the number of planes.
+    inline int NbPlanes() const
+    {
+        return static_cast<int>(m_heights.size());
+    }
+
+private:
+    gp_Vec m_direction;
+    std_Array1OfReal m_heights;
+};
+
+#endif
@@ -0,0 +1,90 @@
+// Describes an axis-aligned bounding box in 3D space by its minimal and maximal corners.
+// A box without point is void: its minimal corner is +Infinite and its maximal corner -Infinite,
+// so that adding a point or a box needs no special case.
+
+#ifndef BND_BOX_H
+#define BND_BOX_H
+
+#include "geometry.h"
+
+#include <limits>
+
+class Bnd_Box
+{
+public:
+    // Creates a void box.
+    Bnd_Box()
+        : m_min(std::numeric_limits<double>::infinity()),
+          m_max(-std::numeric_limits<double>::infinity())
+    {
+    }
+
+    // Creates the box of the corners min and max.
+    Bnd_Box(const gp_Pnt& min, const gp_Pnt& max)
+        : m_min(min),
+          m_max(max)
+    {
+    }
+
+    // Returns true if the box contains no point.
+    inline bool IsVoid() const
+    {
+        return m_min.x > m_max.x;
+    }
+
+    // Enlarges the box to contain the point p.
+    inline void Add(const gp_Pnt& p)
+    {
+        m_min = glm::min(m_min, p);
+        m_max = glm::max(m_max, p);
+    }
+
+    // Enlarges the box to contain the box other.
+    inline void Add(const Bnd_Box& other)
+    {
+        m_min = glm::min(m_min, other.m_min);
+        m_max = glm::max(m_max, other.m_max);
+    }
+
+    // Enlarges the box by gap in all the directions.
+    inline void Enlarge(const double gap)
+    {
+        m_min -= gap;
+        m_max += gap;
+    }
+
+    // Returns the minimal corner.
+    inline const gp_Pnt& CornerMin() const
+    {
+        return m_min;
+    }
+
+    // Returns the maximal corner.
+    inline const gp_Pnt& CornerMax() const
+    {
+        return m_max;
+    }
+
+    // Returns the center of the box.
+    inline gp_Pnt Center() const
+    {
+        return 0.5 * (m_min + m_max);
+    }
+
+    // Returns the half area of the faces of the box, 0 for a void box.
+    inline double HalfArea() const
+    {
+        if (IsVoid())
+        {
+            return 0.0;
+        }
+        const gp_Vec size = m_max - m_min;
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+
+private:
+    gp_Pnt m_min;
+    gp_Pnt m_max;
+};
+
+#endif
@@ -0,0 +1,886 @@
+#include "geom_BSplineCurve.h"
+#include "exceptions.h"
+
+#include <algorithm>
+#include <limits>
+
+static_assert(Geom_BezierKernel::MaxNbPoles == Geom_BSplineCurve::MaxDegree() + 1, "Kernel capacity does not match MaxDegree()");
+
+namespace
+{
+    constexpr int MaxNbPoles = Geom_BezierKernel::MaxNbPoles;
+
+    // Relative rounding error of the poles computed from both sides of a removed knot. A distance below it,
+    // relative to the pole, is not a displacement: a knot inserted by InsertKnots() is removed with a zero tolerance.
+    constexpr double RemovalRoundOff = 1024.0 * std::numeric_limits<double>::epsilon();
+
+    // Computes the non-zero basis functions ders[0][j] of the span, N(span - degree + j), and their
+    // derivatives ders[k][j] up to the order nbDeriv <= degree (The NURBS Book, algorithm A2.3).
+    // The triangle of the basis functions of increasing degrees and the differences of knots share
+    // the table ndu, all the buffers are on the stack.
+    void BasisFunctions(const double* knots, const int span, const double u, const int degree, const int nbDeriv,
+                        double ders[][MaxNbPoles])
+    {
+        double left[MaxNbPoles];
+        double right[MaxNbPoles];
+
+        // The points only need the last row of the triangle (algorithm A2.2).
+        if (nbDeriv == 0)
+        {
+            double* n = ders[0];
+            n[0] = 1.0;
+            for (int j = 1; j <= degree; ++j)
+            {
+                left[j] = u - knots[span + 1 - j];
+                right[j] = knots[span + j] - u;
+                double saved = 0.0;
+                for (int r = 0; r < j; ++r)
+                {
+                    const double temp = n[r] / (right[r + 1] + left[j - r]);
+                    n[r] = saved + right[r + 1] * temp;
+                    saved = left[j - r] * temp;
+                }
+                n[j] = saved;
+            }
+            return;
+        }
+
+        // ndu[j][r], r <= j: knot differences; ndu[r][j], r <= j: basis functions of degree j.
+        double ndu[MaxNbPoles][MaxNbPoles];
+        ndu[0][0] = 1.0;
+        for (int j = 1; j <= degree; ++j)
+        {
+            left[j] = u - knots[span + 1 - j];
+            right[j] = knots[span + j] - u;
+            double saved = 0.0;
+            for (int r = 0; r < j; ++r)
+            {
+                ndu[j][r] = right[r + 1] + left[j - r];
+                const double temp = ndu[r][j - 1] / ndu[j][r];
+                ndu[r][j] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
+            }
+            ndu[j][j] = saved;
+        }
+
+        for (int j = 0; j <= degree; ++j)
+        {
+            ders[0][j] = ndu[j][degree];
+        }
+
+        // Derivatives of the basis function r from the differences of the rows a of the coefficients.
+        double a[2][MaxNbPoles];
+        for (int r = 0; r <= degree; ++r)
+        {
+            int s1 = 0, s2 = 1;
+            a[0][0] = 1.0;
+            for (int k = 1; k <= nbDeriv; ++k)
+            {
+                double d = 0.0;
+                const int rk = r - k, pk = degree - k;
+                if (r >= k)
+                {
+                    a[s2][0] = a[s1][0] / ndu[pk + 1][rk];
+                    d = a[s2][0] * ndu[rk][pk];
+                }
+                const int j1 = rk >= -1 ? 1 : -rk;
+                const int j2 = r - 1 <= pk ? k - 1 : degree - r;
+                for (int j = j1; j <= j2; ++j)
+                {
+                    a[s2][j] = (a[s1][j] - a[s1][j - 1]) / ndu[pk + 1][rk + j];
+                    d += a[s2][j] * ndu[rk + j][pk];
+                }
+                if (r <= pk)
+                {
+                    a[s2][k] = -a[s1][k - 1] / ndu[pk + 1][r];
+                    d += a[s2][k] * ndu[r][pk];
+                }
+                ders[k][r] = d;
+                std::swap(s1, s2);
+            }
+        }
+
+        // Multiply by degree! / (degree - k)!.
+        double factor = degree;
+        for (int k = 1; k <= nbDeriv; ++k)
+        {
+            for (int j = 0; j <= degree; ++j)
+            {
+                ders[k][j] *= factor;
+            }
+            factor *= degree - k;
+        }
+    }
+
+    // Replaces in place the degree + 1 poles q of a span by the poles of its Bezier segment.
+    // The knots t[0], ..., t[2 * degree - 1] of the span are the flat knots from span - degree + 1,
+    // the span is [a, b] = [t[degree - 1], t[degree]]. With the blossom f of the span, q[j] = f(t[j], ..., t[j + degree - 1])
+    // and the Bezier poles are f(a, ..., a, b, ..., b). The first sweep substitutes b from the right:
+    // q[r] = f(t[r], ..., t[degree - 1], b, ..., b), the second one substitutes a for the remaining knots.
+    template <typename Pnt>
+    void SpanToBezier(Pnt* q, const double* t, const int degree)
+    {
+        const double a = t[degree - 1], b = t[degree];
+        for (int r = 1; r <= degree; ++r)
+        {
+            for (int j = degree; j >= r; --j)
+            {
+                const double alpha = (b - t[j - 1]) / (t[j + degree - r] - t[j - 1]);
+                q[j] = (1.0 - alpha) * q[j - 1] + alpha * q[j];
+            }
+        }
+        for (int s = 1; s < degree; ++s)
+        {
+            for (int k = 0; k < degree - s; ++k)
+            {
+                const double beta = (a - t[k + s - 1]) / (b - t[k + s - 1]);
+                q[k] = (1.0 - beta) * q[k] + beta * q[k + 1];
+            }
+        }
+    }
+
+    // Inserts the nbKnots non-decreasing knots x of the spans [a, b - 1] all at once (The NURBS Book, algorithm A5.4).
+    // The poles and the flat knots are refined in place, from the end: the arrays are first extended and the
+    // unchanged tail is shifted, then each new pole is written at an index not lower than the old poles still to read.
+    template <typename Pnt>
+    void RefineKnots(std::vector<Pnt>& poles, std_Array1OfReal& knots, const int degree, const double* x, const int nbKnots,
+                     const int a, const int b)
+    {
+        const int n = static_cast<int>(poles.size()) - 1;
+        const int m = n + degree + 1;
+        const int r = nbKnots - 1;
+        poles.resize(poles.size() + nbKnots);
+        knots.resize(knots.size() + nbKnots);
+        for (int j = n; j >= b - 1; --j)
+        {
+            poles[j + r + 1] = poles[j];
+        }
+        for (int j = m; j >= b + degree; --j)
+        {
+            knots[j + r + 1] = knots[j];
+        }
+
+        int i = b + degree - 1;
+        int k = b + degree + r;
+        for (int j = r; j >= 0; --j)
+        {
+            while (x[j] <= knots[i] && i > a)
+            {
+                poles[k - degree - 1] = poles[i - degree - 1];
+                knots[k] = knots[i];
+                --k;
+                --i;
+            }
+            poles[k - degree - 1] = poles[k - degree];
+            for (int l = 1; l <= degree; ++l)
+            {
+                const int index = k - degree + l;
+                const double alpha = knots[k + l] - x[j];
+                if (alpha == 0.0)
+                {
+                    poles[index - 1] = poles[index];
+                }
+                else
+                {
+                    const double ratio = alpha / (knots[k + l] - knots[i - degree + l]);
+                    poles[index - 1] = ratio * poles[index - 1] + (1.0 - ratio) * poles[index];
+                }
+            }
+            knots[k] = x[j];
+            --k;
+        }
+    }
+
+    // Removes up to count times the knot knots[r] of multiplicity s (The NURBS Book, algorithm A5.8) while the
+    // distance between the pole computed from both sides and the one it replaces, less the rounding error,
+    // is within budget, which is reduced by the distances of the removals. The poles and the flat knots are updated in place: the nbPoles
+    // poles and the nbKnots knots after the removed ones are shifted, the last ones are left to the caller.
+    // The removal reads the knots up to r + degree + 1 and the poles up to r + 1, the arrays may stop there.
+    // Returns the number of removals.
+    template <typename Pnt>
+    int RemoveFlatKnot(Pnt* poles, const int nbPoles, double* knots, const int nbKnots, const int degree,
+                       const int r, const int s, const int count, double& budget)
+    {
+        const int n = nbPoles - 1;
+        const int m = nbKnots - 1;
+        const int order = degree + 1;
+        const double u = knots[r];
+        const int fout = (2 * r - s - degree) / 2;
+        int last = r - s;
+        int first = r - degree;
+
+        Pnt temp[2 * MaxNbPoles + 1];
+        int t = 0;
+        for (; t < count; ++t)
+        {
+            const int off = first - 1;
+            temp[0] = poles[off];
+            temp[last + 1 - off] = poles[last + 1];
+            int i = first, j = last;
+            int ii = 1, jj = last - off;
+            while (j - i > t)
+            {
+                const double alphaI = (u - knots[i]) / (knots[i + order + t] - knots[i]);
+                const double alphaJ = (u - knots[j - t]) / (knots[j + order] - knots[j - t]);
+                temp[ii] = (poles[i] - (1.0 - alphaI) * temp[ii - 1]) / alphaI;
+                temp[jj] = (poles[j] - alphaJ * temp[jj + 1]) / (1.0 - alphaJ);
+                ++i;
+                ++ii;
+                --j;
+                --jj;
+            }
+
+            double error;
+            if (j - i < t)
+            {
+                error = glm::distance(temp[ii - 1], temp[jj + 1]) - RemovalRoundOff * glm::length(temp[jj + 1]);
+            }
+            else
+            {
+                const double alphaI = (u - knots[i]) / (knots[i + order + t] - knots[i]);
+                error = glm::distance(poles[i], alphaI * temp[ii + t + 1] + (1.0 - alphaI) * temp[ii - 1]) - RemovalRoundOff * glm::length(poles[i]);
+            }
+            error = std::max(error, 0.0);
+            if (error > budget)
+            {
+                break;
+            }
+            budget -= error;
+
+            i = first;
+            j = last;
+            while (j - i > t)
+            {
+                poles[i] = temp[i - off];
+                poles[j] = temp[j - off];
+                ++i;
+                --j;
+            }
+            --first;
+            ++last;
+        }
+
+        if (t == 0)
+        {
+            return 0;
+        }
+
+        for (int k = r + 1; k <= m; ++k)
+        {
+            knots[k - t] = knots[k];
+        }
+
+        int j = fout, i = fout;
+        for (int k = 1; k < t; ++k)
+        {
+            if (k % 2 == 1)
+            {
+                ++i;
+            }
+            else
+            {
+                --j;
+            }
+        }
+        for (int k = i + 1; k <= n; ++k)
+        {
+            poles[j++] = poles[k];
+        }
+        return t;
+    }
+
+    // Combines the degree + 1 poles of a span with the basis functions and their derivatives up to nbDeriv.
+    template <typename Pnt, typename Vec>
+    void Combine(const Pnt* poles, const double ders[][MaxNbPoles], const int degree, const int nbDeriv, Vec* a)
+    {
+        for (int k = 0; k <= nbDeriv; ++k)
+        {
+            Vec v(0.0);
+            for (int j = 0; j <= degree; ++j)
+            {
+                v += ders[k][j] * poles[j];
+            }
+            a[k] = v;
+        }
+    }
+}
+
+Geom_BSplineCurve::Geom_BSplineCurve(const gp_Array1OfPnt& poles, const std_Array1OfReal& knots,
+                                     const std_Array1OfInteger& multiplicities, const int degree)
+{
+    Init(poles, nullptr, knots, multiplicities, degree);
+}
+
+Geom_BSplineCurve::Geom_BSplineCurve(const gp_Array1OfPnt& poles, const std_Array1OfReal& weights, const std_Array1OfReal& knots,
+                                     const std_Array1OfInteger& multiplicities, const int degree)
+{
+    // Check weights
+    VALIDATE_ARGUMENT(weights.size() != poles.size(), "weights", "Geom_BSplineCurve: Weights size does not match poles!");
+
+    bool rational = false;
+    for (size_t i = 0; i < weights.size(); ++i)
+    {
+        VALIDATE_ARGUMENT(weights[i] <= gp_Resolution, "weights", "Geom_BSplineCurve: Some weights are near zero!");
+        rational = rational || std::abs(weights[i] - weights[0]) > gp_Resolution;
+    }
+
+    // Init, weights are only kept for a rational curve
+    Init(poles, rational ? weights.data() : nullptr, knots, multiplicities, degree);
+}
+
+void Geom_BSplineCurve::Init(const gp_Array1OfPnt& poles, const double* weights, const std_Array1OfReal& knots,
+                             const std_Array1OfInteger& multiplicities, const int degree)
+{
+    // Check degree
+    VALIDATE_ARGUMENT(degree < 1 || degree > MaxDegree(), "degree", "Geom_BSplineCurve: Degree is lower than 1 or greater than MaxDegree()!");
+
+    // Check knots and multiplicities
+    const int nbKnots = static_cast<int>(knots.size());
+    VALIDATE_ARGUMENT(nbKnots < 2, "knots", "Geom_BSplineCurve: Knots size is less than 2!");
+    VALIDATE_ARGUMENT(multiplicities.size() != knots.size(), "multiplicities", "Geom_BSplineCurve: Multiplicities size does not match knots!");
+
+    int nbFlatKnots = 0;
+    for (int i = 0; i < nbKnots; ++i)
+    {
+        VALIDATE_ARGUMENT(i > 0 && knots[i] - knots[i - 1] <= Precision::PConfusion(), "knots", "Geom_BSplineCurve: Knots are not strictly increasing!");
+
+        const int maxMultiplicity = (i == 0 || i == nbKnots - 1) ? degree + 1 : degree;
+        VALIDATE_ARGUMENT(multiplicities[i] < 1 || multiplicities[i] > maxMultiplicity, "multiplicities", "Geom_BSplineCurve: Multiplicity is invalid!");
+        nbFlatKnots += multiplicities[i];
+    }
+
+    // Check poles
+    const int nbPoles = static_cast<int>(poles.size());
+    VALIDATE_ARGUMENT(nbPoles < degree + 1 || nbPoles != nbFlatKnots - degree - 1, "poles", "Geom_BSplineCurve: Poles size does not match the knots and the degree!");
+
+    m_degree = degree;
+    m_poles = poles;
+    m_knots = knots;
+    m_multiplicities = multiplicities;
+
+    m_flatKnots.clear();
+    m_flatKnots.reserve(nbFlatKnots);
+    for (int i = 0; i < nbKnots; ++i)
+    {
+        m_flatKnots.insert(m_flatKnots.end(), multiplicities[i], knots[i]);
+    }
+
+    // Rational poles are stored in homogeneous coordinates for the evaluation
+    m_wpoles.clear();
+    if (weights)
+    {
+        m_wpoles.resize(nbPoles);
+        for (int i = 0; i < nbPoles; ++i)
+        {
+            m_wpoles[i] = gp_Pnt4d(weights[i] * poles[i], weights[i]);
+        }
+    }
+
+    m_closed = glm::distance(StartPoint(), EndPoint()) <= Precision::Confusion();
+}
+
+void Geom_BSplineCurve::UpdateKnots()
+{
+    m_knots.clear();
+    m_multiplicities.clear();
+    for (const double knot : m_flatKnots)
+    {
+        if (m_knots.empty() || knot != m_knots.back())
+        {
+            m_knots.push_back(knot);
+            m_multiplicities.push_back(0);
+        }
+        ++m_multiplicities.back();
+    }
+
+    if (IsRational())
+    {
+        m_poles.resize(m_wpoles.size());
+        for (int i = 0; i < NbPoles(); ++i)
+        {
+            m_poles[i] = gp_Pnt(m_wpoles[i]) / m_wpoles[i].w;
+        }
+    }
+}
+
+double Geom_BSplineCurve::HomogeneousTolerance(const double tolerance) const
+{
+    if (!IsRational())
+    {
+        return tolerance;
+    }
+
+    // A displacement e of the homogeneous poles moves the curve by at most e (1 + max |P|) / min w.
+    double minWeight = m_wpoles[0].w, maxPole = 0.0;
+    for (int i = 0; i < NbPoles(); ++i)
+    {
+        minWeight = std::min(minWeight, m_wpoles[i].w);
+        maxPole = std::max(maxPole, glm::length(m_poles[i]));
+    }
+    return tolerance * minWeight / (1.0 + maxPole);
+}
+
+void Geom_BSplineCurve::InsertKnots(const double* knots, const int nbKnots)
+{
+    if (nbKnots == 0)
+    {
+        return;
+    }
+
+    // Check knots, snapped to the knots of the curve
+    std_Array1OfReal x(knots, knots + nbKnots);
+    for (int j = 0; j < nbKnots; ++j)
+    {
+        VALIDATE_ARGUMENT(x[j] < FirstParameter() - Precision::PConfusion() || x[j] > LastParameter() + Precision::PConfusion(),
+                          "knots", "Geom_BSplineCurve: Knot is out of the bounds!");
+        VALIDATE_ARGUMENT(j > 0 && x[j] < x[j - 1], "knots", "Geom_BSplineCurve: Knots are not sorted!");
+
+        const auto nearest = std::lower_bound(m_knots.begin(), m_knots.end(), x[j] - Precision::PConfusion());
+        if (nearest != m_knots.end() && std::abs(*nearest - x[j]) <= Precision::PConfusion())
+        {
+            x[j] = *nearest;
+        }
+    }
+
+    // Check multiplicities
+    for (int j = 0; j < nbKnots;)
+    {
+        int count = 1;
+        while (j + count < nbKnots && x[j + count] == x[j])
+        {
+            ++count;
+        }
+        const auto range = std::equal_range(m_flatKnots.begin(), m_flatKnots.end(), x[j]);
+        const bool end = x[j] == m_knots.front() || x[j] == m_knots.back();
+        VALIDATE_ARGUMENT(count + (range.second - range.first) > (end ? m_degree + 1 : m_degree), "knots", "Geom_BSplineCurve: Multiplicity is invalid!");
+        j += count;
+    }
+
+    const int a = Span(x.front());
+    const int b = Span(x.back()) + 1;
+    if (IsRational())
+    {
+        RefineKnots(m_wpoles, m_flatKnots, m_degree, x.data(), nbKnots, a, b);
+        m_poles.resize(m_wpoles.size());
+    }
+    else
+    {
+        RefineKnots(m_poles, m_flatKnots, m_degree, x.data(), nbKnots, a, b);
+    }
+    UpdateKnots();
+}
+
+int Geom_BSplineCurve::RemoveKnot(const int index, const int count, const double tolerance)
+{
+    VALIDATE_ARGUMENT_RANGE(index, 0, NbKnots() - 1);
+    VALIDATE_ARGUMENT(m_knots[index] <= FirstParameter() || m_knots[index] >= LastParameter(), "index", "Geom_BSplineCurve: Knot is not inside the bounds!");
+    VALIDATE_ARGUMENT_RANGE(count, 1, m_multiplicities[index]);
+    VALIDATE_ARGUMENT(tolerance < 0.0, "tolerance", "Geom_BSplineCurve: Tolerance is negative!");
+
+    // Index of the last occurrence of the knot in the flat knots.
+    int r = -1;
+    for (int i = 0; i <= index; ++i)
+    {
+        r += m_multiplicities[i];
+    }
+
+    double budget = HomogeneousTolerance(tolerance);
+    const int nbKnots = static_cast<int>(m_flatKnots.size());
+    int removed;
+    if (IsRational())
+    {
+        removed = RemoveFlatKnot(m_wpoles.data(), NbPoles(), m_flatKnots.data(), nbKnots, m_degree, r, m_multiplicities[index], count, budget);
+        m_wpoles.resize(NbPoles() - removed);
+    }
+    else
+    {
+        removed = RemoveFlatKnot(m_poles.data(), NbPoles(), m_flatKnots.data(), nbKnots, m_degree, r, m_multiplicities[index], count, budget);
+        m_poles.resize(NbPoles() - removed);
+    }
+    if (removed > 0)
+    {
+        m_flatKnots.resize(nbKnots - removed);
+        UpdateKnots();
+    }
+    return removed;
+}
+
+int Geom_BSplineCurve::RemoveKnots(const double tolerance)
+{
+    VALIDATE_ARGUMENT(tolerance < 0.0, "tolerance", "Geom_BSplineCurve: Tolerance is negative!");
+
+    double budget = HomogeneousTolerance(tolerance);
+    const int removed = IsRational() ? RemoveKnots(m_wpoles, budget) : RemoveKnots(m_poles, budget);
+    if (removed > 0)
+    {
+        UpdateKnots();
+    }
+    return removed;
+}
+
+template <typename Pnt>
+int Geom_BSplineCurve::RemoveKnots(std::vector<Pnt>& poles, double& budget)
+{
+    // The sweep keeps a gap of the size of the removals between the updated part of the arrays
+    // and the part still to read, so that a removal only shifts the poles and the knots it reads:
+    // the view [0, nbPoles) of the poles and [0, nbKnots) of the knots is extended from the part after
+    // the gap as the sweep goes, the whole sweep is linear in the number of knots.
+    double* knots = m_flatKnots.data();
+    const int totalPoles = static_cast<int>(poles.size());
+    const int totalKnots = static_cast<int>(m_flatKnots.size());
+    const double last = LastParameter();
+    int gap = 0;
+    int nbPoles = m_degree + 1;
+    int nbKnots = m_degree + 1;
+
+    // [start, r] are the occurrences of a knot inside the bounds in the flat knots.
+    int start = m_degree + 1;
+    while (true)
+    {
+        const int endPoles = std::min(totalPoles - gap, start + m_degree + 2);
+        const int endKnots = std::min(totalKnots - gap, start + 2 * m_degree + 2);
+        for (; nbPoles < endPoles; ++nbPoles)
+        {
+            poles[nbPoles] = poles[nbPoles + gap];
+        }
+        for (; nbKnots < endKnots; ++nbKnots)
+        {
+            knots[nbKnots] = knots[nbKnots + gap];
+        }
+
+        if (start >= totalPoles - gap || knots[start] >= last)
+        {
+            break;
+        }
+        if (knots[start] == knots[m_degree])
+        {
+            ++start;
+            continue;
+        }
+
+        int r = start;
+        while (knots[r + 1] == knots[start])
+        {
+            ++r;
+        }
+        const int multiplicity = r - start + 1;
+        const int count = RemoveFlatKnot(poles.data(), nbPoles, knots, nbKnots, m_degree, r, multiplicity, multiplicity, budget);
+        nbPoles -= count;
+        nbKnots -= count;
+        gap += count;
+        start = r + 1 - count;
+    }
+
+    // Close the gap.
+    for (; nbPoles < totalPoles - gap; ++nbPoles)
+    {
+        poles[nbPoles] = poles[nbPoles + gap];
+    }
+    for (; nbKnots < totalKnots - gap; ++nbKnots)
+    {
+        knots[nbKnots] = knots[nbKnots + gap];
+    }
+    poles.resize(nbPoles);
+    m_flatKnots.resize(nbKnots);
+    return gap;
+}
+
+int Geom_BSplineCurve::Span(const double u) const
+{
+    // The first and last spans are the non-empty ones at the bounds, they extend beyond the bounds.
+    const double* knots = m_flatKnots.data();
+    int first = m_degree, last = NbPoles() - 1;
+    while (first < last && knots[first + 1] <= knots[m_degree])
+    {
+        ++first;
+    }
+    while (last > first && knots[last] >= knots[NbPoles()])
+    {
+        --last;
+    }
+
+    // The last knot of the interior spans not greater than u, empty spans of repeated knots are skipped.
+    // The halving has no branch on the knots, it compiles to conditional moves.
+    if (u >= knots[last])
+    {
+        return last;
+    }
+    const double* base = knots + first;
+    int count = last - first;
+    while (count > 1)
+    {
+        const int half = count / 2;
+        base = base[half] <= u ? base + half : base;
+        count -= half;
+    }
+    return static_cast<int>(base - knots);
+}
+
+int Geom_BSplineCurve::Span(const double u, int& hint) const
+{
+    // The span of the previous lookup or the next one, if they are not empty.
+    const double* knots = m_flatKnots.data();
+    const int last = NbPoles() - 1;
+    if (hint >= m_degree && hint <= last)
+    {
+        for (int span = hint; span <= std::min(hint + 1, last); ++span)
+        {
+            if (knots[span] <= u && u < knots[span + 1])
+            {
+                hint = span;
+                return span;
+            }
+        }
+    }
+
+    hint = Span(u);
+    return hint;
+}
+
+void Geom_BSplineCurve::Evaluate(const double u, const int span, const int nbDeriv, gp_Vec* d) const
+{
+    // The derivatives of the basis functions of order greater than the degree vanish.
+    const int order = std::min(nbDeriv, m_degree);
+    double ders[MaxNbPoles][MaxNbPoles];
+    BasisFunctions(m_flatKnots.data(), span, u, m_degree, order, ders);
+
+    if (!IsRational())
+    {
+        Combine(m_poles.data() + span - m_degree, ders, m_degree, order, d);
+        std::fill(d + order + 1, d + nbDeriv + 1, gp_Vec(0.0));
+        return;
+    }
+
+    gp_Pnt4d buffer[MaxDegree() + 2];
+    std::vector<gp_Pnt4d> heap;
+    gp_Pnt4d* a = buffer;
+    if (nbDeriv > MaxDegree() + 1)
+    {
+        heap.resize(nbDeriv + 1);
+        a = heap.data();
+    }
+    Combine(m_wpoles.data() + span - m_degree, ders, m_degree, order, a);
+    std::fill(a + order + 1, a + nbDeriv + 1, gp_Pnt4d(0.0));
+    Geom_BezierKernel::RationalDerivatives(a, nbDeriv, d);
+}
+
+void Geom_BSplineCurve::D0 (const double u, gp_Pnt& p) const
+{
+    Evaluate(u, Span(u), 0, &p);
+}
+
+void Geom_BSplineCurve::D1 (const double u, gp_Pnt& p, gp_Vec& v1) const
+{
+    gp_Vec d[2];
+    Evaluate(u, Span(u), 1, d);
+    p = d[0];
+    v1 = d[1];
+}
+
+void Geom_BSplineCurve::D2 (const double u, gp_Pnt& p, gp_Vec& v1, gp_Vec& v2) const
+{
+    gp_Vec d[3];
+    Evaluate(u, Span(u), 2, d);
+    p = d[0];
+    v1 = d[1];
+    v2 = d[2];
+}
+
+gp_Vec Geom_BSplineCurve::DN(const double u, const int n) const
+{
+    VALIDATE_ARGUMENT(n < 1, "n", "Geom_BSplineCurve: Derivative order must be at least 1!");
+
+    // The derivatives of order greater than the degree of a polynomial curve vanish.
+    if (!IsRational() && n > m_degree)
+    {
+        return gp_Vec(0.0);
+    }
+
+    gp_Vec buffer[MaxDegree() + 2];
+    std::vector<gp_Vec> heap;
+    gp_Vec* d = buffer;
+    if (n > MaxDegree() + 1)
+    {
+        heap.resize(n + 1);
+        d = heap.data();
+    }
+    Evaluate(u, Span(u), n, d);
+    return d[n];
+}
+
+void Geom_BSplineCurve::Derivatives(const double u, const int n, gp_Vec* d) const
+{
+    VALIDATE_ARGUMENT(n < 0, "n", "Geom_BSplineCurve: Derivative order must not be negative!");
+
+    Evaluate(u, Span(u), n, d);
+}
+
+void Geom_BSplineCurve::D0Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p) const
+{
+    EvaluateBatch(params, nbParams, 0, &p);
+}
+
+void Geom_BSplineCurve::D1Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const
+{
+    const gp_SoAOfXYZ d[2] = {p, v1};
+    EvaluateBatch(params, nbParams, 1, d);
+}
+
+void Geom_BSplineCurve::D2Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1, const gp_SoAOfXYZ& v2) const
+{
+    const gp_SoAOfXYZ d[3] = {p, v1, v2};
+    EvaluateBatch(params, nbParams, 2, d);
+}
+
+void Geom_BSplineCurve::EvaluateBatch(const double* params, const int nbParams, const int nbDeriv, const gp_SoAOfXYZ* d) const
+{
+    // The hint is local to the batch, increasing parameters are located in constant time.
+    int hint = m_degree;
+    gp_Vec v[3];
+    for (int i = 0; i < nbParams; ++i)
+    {
+        Evaluate(params[i], Span(params[i], hint), nbDeriv, v);
+        for (int k = 0; k <= nbDeriv; ++k)
+        {
+            d[k].SetValue(i, v[k]);
+        }
+    }
+}
+
+int Geom_BSplineCurve::NbBezierSegments() const
+{
+    int nbSegments = 0;
+    for (int span = m_degree; span < NbPoles(); ++span)
+    {
+        nbSegments += m_flatKnots[span] < m_flatKnots[span + 1];
+    }
+    return nbSegments;
+}
+
+void Geom_BSplineCurve::BezierSegments(gp_Pnt* poles, double* weights) const
+{
+    const int nbSegmentPoles = m_degree + 1;
+    for (int span = m_degree; span < NbPoles(); ++span)
+    {
+        if (m_flatKnots[span] == m_flatKnots[span + 1])
+        {
+            continue;
+        }
+
+        const double* t = m_flatKnots.data() + span - m_degree + 1;
+        if (!IsRational())
+        {
+            std::copy(m_poles.begin() + span - m_degree, m_poles.begin() + span + 1, poles);
+            SpanToBezier(poles, t, m_degree);
+            if (weights)
+            {
+                std::fill(weights, weights + nbSegmentPoles, 1.0);
+            }
+        }
+        else
+        {
+            gp_Pnt4d q[MaxNbPoles];
+            std::copy(m_wpoles.begin() + span - m_degree, m_wpoles.begin() + span + 1, q);
+            SpanToBezier(q, t, m_degree);
+            for (int j = 0; j < nbSegmentPoles; ++j)
+            {
+                poles[j] = gp_Pnt(q[j]) / q[j].w;
+                if (weights)
+                {
+                    weights[j] = q[j].w;
+                }
+            }
+        }
+
+        poles += nbSegmentPoles;
+        if (weights)
+        {
+            weights += nbSegmentPoles;
+        }
+    }
+}
+
+bool Geom_BSplineCurve::IsCN(const int n) const
+{
+    int multiplicity = 0;
+    for (int i = 1; i < NbKnots() - 1; ++i)
+    {
+        multiplicity = std::max(multiplicity, m_multiplicities[i]);
+    }
+    return NbKnots() == 2 || n <= m_degree - multiplicity;
+}
+
+Geom_Continuity Geom_BSplineCurve::Continuity() const
+{
+    if (NbKnots() == 2)
+    {
+        return Geom_Continuity::Geom_CN;
+    }
+
+    int multiplicity = 0;
+    for (int i = 1; i < NbKnots() - 1; ++i)
+    {
+        multiplicity = std::max(multiplicity, m_multiplicities[i]);
+    }
+    switch (m_degree - multiplicity)
+    {
+    case 0:
+        return Geom_Continuity::Geom_C0;
+    case 1:
+        return Geom_Continuity::Geom_C1;
+    case 2:
+        return Geom_Continuity::Geom_C2;
+    case 3:
+        return Geom_Continuity::Geom_C3;
+    default:
+        return Geom_Continuity::Geom_CN;
+    }
+}
+
+gp_Pnt Geom_BSplineCurve::StartPoint() const
+{
+    if (m_multiplicities.front() == m_degree + 1)
+    {
+        return m_poles.front();
+    }
+    return Value(FirstParameter());
+}
+
+gp_Pnt Geom_BSplineCurve::EndPoint() const
+{
+    if (m_multiplicities.back() == m_degree + 1)
+    {
+        return m_poles.back();
+    }
+    return Value(LastParameter());
+}
+
+const gp_Pnt& Geom_BSplineCurve::Pole(const int index) const
+{
+    // Check index
+    VALIDATE_ARGUMENT_RANGE(index, 0, NbPoles() - 1);
+
+    return m_poles[index];
+}
+
+double Geom_BSplineCurve::Weight(const int index) const
+{
+    // Check index
+    VALIDATE_ARGUMENT_RANGE(index, 0, NbPoles() - 1);
+
+    return IsRational() ? m_wpoles[index].w : 1.0;
+}
+
+void Geom_BSplineCurve::Weights(std_Array1OfReal& weights) const
+{
+    weights.resize(NbPoles());
+    for (int i = 0; i < NbPoles(); ++i)
+    {
+        weights[i] = IsRational() ? m_wpoles[i].w : 1.0;
+    }
+}
+
+handle<Geom_Curve> Geom_BSplineCurve::Copy() const
+{
+    return std::make_shared<Geom_BSplineCurve>(*this);
+}
@@ -0,0 +1,230 @@
+// Describes a rational or non-rational B-spline curve
+// - a non-rational B-spline curve is defined by a table of poles (also called control points),
+//   a table of knots with their multiplicities and a degree,
+// - a rational B-spline curve is defined by a table of poles with varying weights.
+// The knots are also stored as the flat knot sequence, where each knot is repeated by its
+// multiplicity, which is read by the span lookup and the evaluation.
+// The curve is non-periodic, the multiplicities of the first and last knots are at most Degree() + 1
+// and the interior ones at most Degree(). The curve is defined on [FirstParameter(), LastParameter()]
+// and extended beyond by the polynomials of its first and last spans.
+
+#ifndef GEOM_BSPLINECURVE_H
+#define GEOM_BSPLINECURVE_H
+
+#include "geom_BoundedCurve.h"
+#include "geom_BezierKernel.h"
+
+class Geom_BSplineCurve: public Geom_BoundedCurve
+{
+public:
+    // Creates a non-rational B-spline curve of the degree on the poles, knots and multiplicities.
+    // Raised if degree is not in the range [1, MaxDegree()], if the knots are not strictly increasing,
+    // if knots and multiplicities don't have the same length, if a multiplicity is lower than 1
+    // or greater than the above bounds, or if the number of poles is not the sum of the multiplicities - degree - 1.
+    Geom_BSplineCurve(const gp_Array1OfPnt& poles, const std_Array1OfReal& knots, const std_Array1OfInteger& multiplicities,
+                      const int degree);
+
+    // Creates a rational B-spline curve, see above. If all the weights are identical the curve is considered as non rational.
+    // Raised if poles and weights don't have the same length or if a weight is not greater than Resolution from package geometry.
+    Geom_BSplineCurve(const gp_Array1OfPnt& poles, const std_Array1OfReal& weights, const std_Array1OfReal& knots,
+                      const std_Array1OfInteger& multiplicities, const int degree);
+
+    void D0 (const double u, gp_Pnt& p) const override;
+
+    void D1 (const double u, gp_Pnt& p, gp_Vec& v1) const override;
+
+    void D2 (const double u, gp_Pnt& p, gp_Vec& v1, gp_Vec& v2) const override;
+
+    // The derivatives at a knot are the ones of the span starting at the knot.
+    gp_Vec DN(const double u, const int n) const override;
+
+    // Computes the point d[0] and the derivatives d[1], ..., d[n] of parameter u from a single evaluation
+    // of the basis functions of the span, the derivatives of a rational curve follow from the Leibniz rule.
+    void Derivatives(const double u, const int n, gp_Vec* d) const override;
+
+    // Batch evaluations, the span of each parameter is searched from the span of the previous one.
+    void D0Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p) const override;
+
+    void D1Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const override;
+
+    void D2Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1, const gp_SoAOfXYZ& v2) const override;
+
+    // Returns the index i of the span of the parameter u in the flat knot sequence, KnotSequence()[i] <= u < KnotSequence()[i + 1],
+    // in the range [Degree(), NbPoles() - 1], located by a binary search. Empty spans of repeated knots are skipped,
+    // parameters out of the bounds are in the first or last non-empty span.
+    int Span(const double u) const;
+
+    // Same as above, the span hint of a previous lookup of the caller is tried first, then the next one,
+    // so that increasing parameters are located in constant time. The hint is owned by the caller, e.g. a loop
+    // on parameters, so that concurrent readers do not share it; any value is valid as a first hint.
+    // hint is set to the span found.
+    int Span(const double u, int& hint) const;
+
+    // Returns the number of Bezier segments of the curve, the number of non-empty spans.
+    int NbBezierSegments() const;
+
+    // Computes the poles of the Bezier segments of the curve, in increasing parameters: the poles of the segment i
+    // are stored in poles[i * (Degree() + 1)], ..., poles[(i + 1) * (Degree() + 1) - 1] and, if weights is not null,
+    // their weights in weights at the same indices, as in Geom_BezierCurve::SplitAt().
+    // The segment of each span follows from the poles of the span alone by raising the multiplicities
+    // of its bounds to Degree(), in place in the output and in O(Degree()^2).
+    void BezierSegments(gp_Pnt* poles, double* weights) const;
+
+    // Inserts the nbKnots knots, non-decreasing and in [FirstParameter(), LastParameter()], all at once by the
+    // simultaneous refinement of the knot sequence (Oslo algorithm), in place in the poles and the knots.
+    // A knot closer than PConfusion to a knot of the curve raises its multiplicity.
+    // Raised if a knot is out of the bounds or not sorted, or if a multiplicity would exceed Degree(),
+    // Degree() + 1 for the first and last knots.
+    void InsertKnots(const double* knots, const int nbKnots);
+
+    // Removes up to count times the knot of range index while the curve moves by at most tolerance,
+    // and returns the number of removals. The knot is removed when its multiplicity reaches 0.
+    // Raised if the knot is not inside ]FirstParameter(), LastParameter()[, if count is not in the range
+    // [1, Multiplicities()[index]] or if tolerance is negative.
+    int RemoveKnot(const int index, const int count, const double tolerance);
+
+    // Removes as many interior knots as possible, in one sweep over the knots and in place, while the curve
+    // moves by at most tolerance: the sum of the bounds of the displacements of the removals is kept within
+    // tolerance. Displacements within the rounding of the poles are not counted, so that the knots inserted
+    // by InsertKnots() are removed with a zero tolerance. Returns the number of removals, counted with the multiplicities.
+    // Raised if tolerance is negative.
+    int RemoveKnots(const double tolerance);
+
+    // Returns true if the distance between the first point and the last point of the curve
+    // is not more than Confusion from package precision.
+    inline bool IsClosed() const override
+    {
+        return m_closed;
+    }
+
+    // Returns true if the curve is CN: n is not greater than the degree minus the highest interior multiplicity.
+    bool IsCN(const int n) const override;
+
+    // Returns false if all the weights are identical.
+    inline bool IsRational() const
+    {
+        return !m_wpoles.empty();
+    }
+
+    // Returns the global continuity of the curve, from the highest interior multiplicity.
+    Geom_Continuity Continuity() const override;
+
+    // Returns the polynomial degree of the curve.
+    inline int Degree() const
+    {
+        return m_degree;
+    }
+
+    // Returns Value (FirstParameter()), the first pole if the first knot has the multiplicity Degree() + 1.
+    gp_Pnt StartPoint() const override;
+
+    // Returns Value (LastParameter()), the last pole if the last knot has the multiplicity Degree() + 1.
+    gp_Pnt EndPoint() const override;
+
+    // Returns KnotSequence()[Degree()].
+    inline double FirstParameter() const override
+    {
+        return m_flatKnots[m_degree];
+    }
+
+    // Returns KnotSequence()[NbPoles()].
+    inline double LastParameter() const override
+    {
+        return m_flatKnots[NbPoles()];
+    }
+
+    // Returns the number of poles.
+    inline int NbPoles() const
+    {
+        return static_cast<int>(m_poles.size());
+    }
+
+    // Returns the pole of range index.
+    // Raised if the index is not in the range [0, NbPoles() - 1].
+    const gp_Pnt& Pole(const int index) const;
+
+    // Returns all the poles of the curve.
+    inline const gp_Array1OfPnt& Poles() const
+    {
+        return m_poles;
+    }
+
+    // Returns the weight of range index.
+    // Raised if the index is not in the range [0, NbPoles() - 1].
+    double Weight(const int index) const;
+
+    // Returns all the weights of the curve.
+    void Weights(std_Array1OfReal& weights) const;
+
+    // Returns the number of distinct knots.
+    inline int NbKnots() const
+    {
+        return static_cast<int>(m_knots.size());
+    }
+
+    // Returns the distinct knots.
+    inline const std_Array1OfReal& Knots() const
+    {
+        return m_knots;
+    }
+
+    // Returns the multiplicities of the knots.
+    inline const std_Array1OfInteger& Multiplicities() const
+    {
+        return m_multiplicities;
+    }
+
+    // Returns the knots repeated by their multiplicities, NbPoles() + Degree() + 1 values.
+    inline const std_Array1OfReal& KnotSequence() const
+    {
+        return m_flatKnots;
+    }
+
+    // Returns the value of the maximum polynomial degree of any Geom_BSplineCurve curve. This value is 25.
+    constexpr static int MaxDegree()
+    {
+        return 25;
+    }
+
+    // Creates a new object which is a copy of this B-spline curve.
+    handle<Geom_Curve> Copy() const override;
+
+private:
+    // Checks the arguments and sets the curve. If weights is null the curve is non-rational.
+    void Init(const gp_Array1OfPnt& poles, const double* weights, const std_Array1OfReal& knots,
+              const std_Array1OfInteger& multiplicities, const int degree);
+
+    // Rebuilds the distinct knots and the multiplicities from the flat knot sequence, and the poles of
+    // a rational curve from the homogeneous poles, after a modification of the knots.
+    void UpdateKnots();
+
+    // Removes the interior knots within the budget, see RemoveKnots(), from the poles read by the evaluation.
+    template <typename Pnt>
+    int RemoveKnots(std::vector<Pnt>& poles, double& budget);
+
+    // Returns the displacement of the homogeneous poles allowed by the tolerance on the curve.
+    double HomogeneousTolerance(const double tolerance) const;
+
+    // Computes the point d[0] and the derivatives d[1], ..., d[nbDeriv] of the parameter u in the span.
+    // The basis functions and the poles of the span are combined in buffers on the stack.
+    void Evaluate(const double u, const int span, const int nbDeriv, gp_Vec* d) const;
+
+    // Computes the points and the derivatives up to nbDeriv (<= 2) of a batch of parameters into d[0..nbDeriv].
+    void EvaluateBatch(const double* params, const int nbParams, const int nbDeriv, const gp_SoAOfXYZ* d) const;
+
+private:
+    int m_degree;
+    bool m_closed;
+
+    gp_Array1OfPnt m_poles;
+
+    // Poles of a rational curve in homogeneous coordinates (w*x, w*y, w*z, w),
+    // empty for a non-rational curve.
+    gp_Array1OfPnt4d m_wpoles;
+
+    std_Array1OfReal m_knots;
+    std_Array1OfInteger m_multiplicities;
+    std_Array1OfReal m_flatKnots;
+};
+
+#endif
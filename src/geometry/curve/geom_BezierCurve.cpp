@@ -1,6 +1,13 @@
 #include "geom_BezierCurve.h"
+#include "geom_BezierEvaluator.h"
 #include "exceptions.h"
 
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+static_assert(Geom_BezierKernel::MaxNbPoles == Geom_BezierCurve::MaxDegree() + 1, "Kernel capacity does not match MaxDegree()");
+
 // check rationality of an array of weights
 static bool Rational(const std_Array1OfReal& weights)
 {
@@ -17,21 +24,105 @@ static bool Rational(const std_Array1OfReal& weights)
     return rational;
 }
 
+// check rationality of an array of homogeneous poles
+static bool Rational(const gp_Pnt4d* wpoles, const int nbPoles)
+{
+    for (int i = 0; i < nbPoles - 1; ++i)
+    {
+        if (std::abs(wpoles[i].w - wpoles[i + 1].w) > gp_Resolution)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Replaces in place the poles of a Bezier curve by the poles of its segment [u1, u2], the blossom
+// values Q[i] = b(u1, ..., u1, u2, ..., u2) with i arguments u2.
+// This is two successive de Casteljau subdivisions, not a single pass: the first one substitutes the
+// bound on the longer side of the segment, the second one the other bound at a ratio of denominator
+// at least 0.5. Each value Q[i] needs its own mix of arguments, so a single triangle cannot produce
+// all of them and evaluating each one directly costs O(n^3); the two sweeps keep O(n^2) operations,
+// no temporary buffer and only convex combinations.
+template <typename Pnt>
+static void Blossom(Pnt* poles, const int degree, const double u1, const double u2)
+{
+    const double low = std::min(u1, u2), high = std::max(u1, u2);
+    if (high >= 1.0 - low)
+    {
+        // b(0, ..., 0, high, ..., high), then the arguments 0 become low = (1 - t) 0 + t high.
+        for (int r = 1; r <= degree; ++r)
+        {
+            for (int j = degree; j >= r; --j)
+            {
+                poles[j] = (1.0 - high) * poles[j - 1] + high * poles[j];
+            }
+        }
+        const double t = low / high;
+        for (int r = 1; r <= degree; ++r)
+        {
+            for (int j = 0; j <= degree - r; ++j)
+            {
+                poles[j] = (1.0 - t) * poles[j] + t * poles[j + 1];
+            }
+        }
+    }
+    else
+    {
+        // b(low, ..., low, 1, ..., 1), then the arguments 1 become high = (1 - t) low + t 1.
+        for (int r = 1; r <= degree; ++r)
+        {
+            for (int j = 0; j <= degree - r; ++j)
+            {
+                poles[j] = (1.0 - low) * poles[j] + low * poles[j + 1];
+            }
+        }
+        const double t = (high - low) / (1.0 - low);
+        for (int r = 1; r <= degree; ++r)
+        {
+            for (int j = degree; j >= r; --j)
+            {
+                poles[j] = (1.0 - t) * poles[j - 1] + t * poles[j];
+            }
+        }
+    }
+
+    // The segment is oriented from u1 to u2.
+    if (u1 > u2)
+    {
+        std::reverse(poles, poles + degree + 1);
+    }
+}
+
+// Publishes a cache built by a reader. Concurrent readers may build it at the same time:
+// the first published wins, the others are discarded.
+template <typename Cache>
+static const Cache& Publish(std::atomic<const Cache*>& cache, const Cache* built)
+{
+    const Cache* expected = nullptr;
+    if (cache.compare_exchange_strong(expected, built, std::memory_order_acq_rel))
+    {
+        return *built;
+    }
+    delete built;
+    return *expected;
+}
+
 Geom_BezierCurve::Geom_BezierCurve(const gp_Array1OfPnt& poles)
 {
     // Check poles
     int nbPoles = poles.size();
-    VALIDATE_ARGUMENT(nbPoles >= 2 && nbPoles <= (MaxDegree() + 1), "poles", "Poles size must be greater than 1 and at most MaxDegree() + 1!");
+    VALIDATE_ARGUMENT(nbPoles < 2 || nbPoles > (MaxDegree() + 1), "poles", "Geom_BezierCurve: Poles size is less than 2 or more than MaxDegree() + 1!");
 
     // Init non-rational
-    Init(poles, std_Array1OfReal());
+    Init(poles.data(), nbPoles, nullptr, std::pmr::get_default_resource());
 }
 
 Geom_BezierCurve::Geom_BezierCurve(const gp_Array1OfPnt& poles, const std_Array1OfReal& weights)
 {
     // Check poles
     int nbPoles = poles.size();
-    VALIDATE_ARGUMENT(nbPoles < 2 || nbPoles <= (MaxDegree() + 1), "poles", "Geom_BezierCurve: Poles size is less than 2 or more than MaxDegree() + 1!");
+    VALIDATE_ARGUMENT(nbPoles < 2 || nbPoles > (MaxDegree() + 1), "poles", "Geom_BezierCurve: Poles size is less than 2 or more than MaxDegree() + 1!");
 
     // Check weights
     int nbWeights = weights.size();
@@ -45,37 +136,115 @@ Geom_BezierCurve::Geom_BezierCurve(const gp_Array1OfPnt& poles, const std_Array1
     // Check really rational
     bool rational = Rational(weights);
 
-    // Copy weights
-    std_Array1OfReal nweights;
-    if(rational)
+    // Init, weights are only kept for a rational curve
+    Init(poles.data(), nbPoles, rational ? weights.data() : nullptr, std::pmr::get_default_resource());
+}
+
+Geom_BezierCurve::Geom_BezierCurve(const gp_Pnt* poles, const int nbPoles, const double* weights, std::pmr::memory_resource* resource)
+{
+    // Check poles and resource
+    VALIDATE_ARGUMENT(nbPoles < 2 || nbPoles > (MaxDegree() + 1), "poles", "Geom_BezierCurve: Poles size is less than 2 or more than MaxDegree() + 1!");
+    VALIDATE_ARGUMENT(resource == nullptr, "resource", "Geom_BezierCurve: Resource is null!");
+
+    // Check weights and rationality
+    bool rational = false;
+    if (weights)
     {
-        nweights = weights;
+        for (int i = 0; i < nbPoles; ++i)
+        {
+            VALIDATE_ARGUMENT(weights[i] <= gp_Resolution, "weights", "Geom_BezierCurve: Some weights are near zero!");
+            rational = rational || std::abs(weights[i] - weights[0]) > gp_Resolution;
+        }
     }
 
-    // Init
-    Init(poles, nweights);
+    Init(poles, nbPoles, rational ? weights : nullptr, resource);
+}
+
+handle<Geom_BezierCurve> Geom_BezierCurve::Make(std::pmr::memory_resource* resource, const gp_Pnt* poles, const int nbPoles,
+                                                const double* weights)
+{
+    VALIDATE_ARGUMENT(resource == nullptr, "resource", "Geom_BezierCurve: Resource is null!");
+
+    return std::allocate_shared<Geom_BezierCurve>(std::pmr::polymorphic_allocator<Geom_BezierCurve>(resource),
+                                                  poles, nbPoles, weights, resource);
+}
+
+static_assert(std::is_trivially_copyable<gp_Pnt>::value && std::is_trivially_copyable<gp_Pnt4d>::value,
+              "The poles are stored in the raw memory of a block.");
+
+Geom_BezierCurve::Data::Data(std::pmr::memory_resource* resource, const int nbPoles, const bool rational)
+    : refCount(1),
+      nbPoles(nbPoles),
+      rational(rational),
+      resource(resource)
+{
 }
 
-void Geom_BezierCurve::Init(const gp_Array1OfPnt& poles, const std_Array1OfReal& weights)
+// Size of a block with its poles.
+static size_t BlockSize(const int nbPoles, const bool rational, const size_t header)
+{
+    return header + nbPoles * (sizeof(gp_Pnt) + (rational ? sizeof(gp_Pnt4d) : 0));
+}
+
+Geom_BezierCurve::Data* Geom_BezierCurve::Data::Create(std::pmr::memory_resource* resource, const int nbPoles, const bool rational)
+{
+    static_assert(sizeof(Data) % alignof(gp_Pnt4d) == 0 && alignof(Data) >= alignof(gp_Pnt4d),
+                  "The poles follow the block.");
+
+    void* memory = resource->allocate(BlockSize(nbPoles, rational, sizeof(Data)), alignof(Data));
+    return new (memory) Data(resource, nbPoles, rational);
+}
+
+void Geom_BezierCurve::Data::Release(Data* data)
+{
+    if (data == nullptr || data->refCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    std::pmr::memory_resource* resource = data->resource;
+    const size_t size = BlockSize(data->nbPoles, data->rational, sizeof(Data));
+    data->~Data();
+    resource->deallocate(data, size, alignof(Data));
+}
+
+Geom_BezierCurve::Data::~Data()
+{
+    delete hodographs.load(std::memory_order_relaxed);
+}
+
+void Geom_BezierCurve::Data::Invalidate()
+{
+    delete hodographs.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void Geom_BezierCurve::Init(const gp_Pnt* poles, const int nbPoles, const double* weights, std::pmr::memory_resource* resource)
 {
     // Check closed
-    m_closed = glm::distance(poles[0], poles[poles.size() - 1]) <= Precision::Confusion();
+    m_closed = glm::distance(poles[0], poles[nbPoles - 1]) <= Precision::Confusion();
 
     // Check rational
-    bool rational = (weights.size() != 0);
+    bool rational = (weights != nullptr);
 
     // Copy poles
-    m_poles = poles;
+    m_data = DataRef(Data::Create(resource, nbPoles, rational));
+    std::copy(poles, poles + nbPoles, m_data->Poles());
 
+    // Rational poles are also stored in homogeneous coordinates for the evaluation
     if (rational)
     {
-        m_weights = weights;
+        for (int i = 0; i < nbPoles; ++i)
+        {
+            m_data->WPoles()[i] = gp_Pnt4d(weights[i] * poles[i], weights[i]);
+        }
     }
+
+    m_evaluator = Geom_BezierEvaluator::Select(Degree(), rational);
 }
 
 
 
-void Geom_BezierCurve::Increase(const double degree)
+void Geom_BezierCurve::Increase(const int degree)
 {
     // Check new degree
     if(degree == Degree())
@@ -85,16 +254,105 @@ void Geom_BezierCurve::Increase(const double degree)
 
     VALIDATE_ARGUMENT(degree < Degree() || degree > MaxDegree(), "degree", "Geom_BezierCurve: New degree is invalid!");
 
+    const int initialDegree = Degree();
+    Data& data = MutableData(degree + 1, IsRational());
+    gp_Pnt* poles = data.Poles();
+    if (IsRational())
+    {
+        // The weights are elevated with the poles in homogeneous coordinates.
+        gp_Pnt4d* wpoles = data.WPoles();
+        Geom_BezierKernel::Elevate(wpoles, initialDegree, degree);
+        for (int i = 0; i <= degree; ++i)
+        {
+            poles[i] = gp_Pnt(wpoles[i]) / wpoles[i].w;
+        }
+    }
+    else
+    {
+        Geom_BezierKernel::Elevate(poles, initialDegree, degree);
+    }
+
+    m_evaluator = Geom_BezierEvaluator::Select(degree, IsRational());
 }
 
-void Geom_BezierCurve::Increase(const double degree)
+void Geom_BezierCurve::Segment(const double u1, const double u2)
 {
+    // Check parameters
+    VALIDATE_ARGUMENT_RANGE(u1, 0.0, 1.0);
+    VALIDATE_ARGUMENT_RANGE(u2, 0.0, 1.0);
+    VALIDATE_ARGUMENT(std::abs(u2 - u1) <= Precision::PConfusion(), "u2", "Geom_BezierCurve: Segment bounds are identical!");
+
+    Data& data = MutableData();
+    const int degree = Degree();
+    gp_Pnt* poles = data.Poles();
+    if (IsRational())
+    {
+        gp_Pnt4d* wpoles = data.WPoles();
+        Blossom(wpoles, degree, u1, u2);
+        for (int i = 0; i <= degree; ++i)
+        {
+            poles[i] = gp_Pnt(wpoles[i]) / wpoles[i].w;
+        }
+    }
+    else
+    {
+        Blossom(poles, degree, u1, u2);
+    }
 
+    m_closed = glm::distance(StartPoint(), EndPoint()) <= Precision::Confusion();
 }
 
-void Geom_BezierCurve::Segment(const double u1, const double u2)
+void Geom_BezierCurve::SplitAt(const double* params, const int nbParams, gp_Pnt* poles, double* weights) const
 {
+    // Check parameters
+    for (int i = 0; i < nbParams; ++i)
+    {
+        const double previous = (i == 0) ? 0.0 : params[i - 1];
+        VALIDATE_ARGUMENT(params[i] <= previous || params[i] >= 1.0, "params", "Geom_BezierCurve: Split parameters must increase strictly in ]0, 1[!");
+    }
 
+    // The rest of the curve after the last cut is subdivided at the next one.
+    const int degree = Degree();
+    const bool rational = IsRational();
+    gp_Pnt4d rest[MaxDegree() + 1];
+    for (int j = 0; j <= degree; ++j)
+    {
+        rest[j] = rational ? m_data->WPoles()[j] : gp_Pnt4d(m_data->Poles()[j], 1.0);
+    }
+
+    double start = 0.0;
+    for (int piece = 0; piece <= nbParams; ++piece)
+    {
+        // The last piece is the rest itself.
+        const gp_Pnt4d* left = rest;
+        gp_Pnt4d cut[MaxDegree() + 1];
+        if (piece < nbParams)
+        {
+            // In place, the triangle leaves the poles of the right part in rest.
+            const double s = (params[piece] - start) / (1.0 - start);
+            cut[0] = rest[0];
+            for (int r = 1; r <= degree; ++r)
+            {
+                for (int j = 0; j <= degree - r; ++j)
+                {
+                    rest[j] = (1.0 - s) * rest[j] + s * rest[j + 1];
+                }
+                cut[r] = rest[0];
+            }
+            start = params[piece];
+            left = cut;
+        }
+
+        gp_Pnt* outPoles = poles + piece * (degree + 1);
+        for (int j = 0; j <= degree; ++j)
+        {
+            outPoles[j] = gp_Pnt(left[j]) / left[j].w;
+            if (weights)
+            {
+                weights[piece * (degree + 1) + j] = rational ? left[j].w : 1.0;
+            }
+        }
+    }
 }
 
 void Geom_BezierCurve::SetPole(const int index, const gp_Pnt& p)
@@ -102,7 +360,13 @@ void Geom_BezierCurve::SetPole(const int index, const gp_Pnt& p)
     // Check index
     VALIDATE_ARGUMENT_RANGE(index, 0, Degree());
 
-    m_poles[index] = p;
+    Data& data = MutableData();
+    data.Poles()[index] = p;
+    if (IsRational())
+    {
+        gp_Pnt4d& wpole = data.WPoles()[index];
+        wpole = gp_Pnt4d(wpole.w * p, wpole.w);
+    }
 
     // Update closed
     if (index == 0 || index == Degree())
@@ -127,97 +391,471 @@ void Geom_BezierCurve::SetWeight(const int index, const double weight)
 
     // Compute new rationality
     bool rational = IsRational();
-    if(!rational)
+    if(!rational && std::abs(weight - 1.0) <= gp_Resolution)
     {
         // A weight of 1 does not turn to rational
-        if(std::abs(weight - 1.0) <= gp_Resolution)
+        return;
+    }
+
+    Data& data = MutableData(NbPoles(), true);
+    if(!rational)
+    {
+        // Set weights of 1.
+        for (int i = 0; i < NbPoles(); ++i)
         {
-            return;
+            data.WPoles()[i] = gp_Pnt4d(data.Poles()[i], 1.0);
         }
-        // Set weights of 1.
-        m_weights = std_Array1OfReal(NbPoles(), 1.0);
+        m_evaluator = Geom_BezierEvaluator::Select(Degree(), true);
     }
 
-    m_weights[index] = weight;
+    data.WPoles()[index] = gp_Pnt4d(weight * data.Poles()[index], weight);
 
     // Is it turning into non-rational?
-    if(rational && !Rational(m_weights))
+    if(rational && !Rational(data.WPoles(), NbPoles()))
     {
-        m_weights.clear();
+        MutableData(NbPoles(), false);
+        m_evaluator = Geom_BezierEvaluator::Select(Degree(), false);
     }
 }
 
 void Geom_BezierCurve::D0 (const double u, gp_Pnt& p) const
 {
-    
+    Evaluate(u, 0, &p);
 }
 
 void Geom_BezierCurve::D1 (const double u, gp_Pnt& p, gp_Vec& v1) const
 {
-
+    gp_Vec d[2];
+    Evaluate(u, 1, d);
+    p = d[0];
+    v1 = d[1];
 }
 
 void Geom_BezierCurve::D2 (const double u, gp_Pnt& p, gp_Vec& v1, gp_Vec& v2) const
 {
-
+    gp_Vec d[3];
+    Evaluate(u, 2, d);
+    p = d[0];
+    v1 = d[1];
+    v2 = d[2];
 }
 
 gp_Vec Geom_BezierCurve::DN(const double u, const int n) const
 {
+    VALIDATE_ARGUMENT(n < 1, "n", "Geom_BezierCurve: Derivative order must be at least 1!");
+
+    // The derivatives of order greater than the degree of a polynomial curve vanish.
+    if (!IsRational() && n > Degree())
+    {
+        return gp_Vec(0.0);
+    }
+
+    // Without the Leibniz rule, a single point of the hodograph of order n is needed.
+    if (!IsRational() && n > Geom_BezierEvaluator::MaxNbDeriv)
+    {
+        const HodographPoles& hodographs = Hodographs();
+        gp_Pnt4d a;
+        Geom_BezierKernel::Casteljau(hodographs.Poles(n), Degree() - n, u, 0, &a);
+        return gp_Vec(a);
+    }
 
+    gp_Vec buffer[MaxDegree() + 2];
+    std::vector<gp_Vec> heap;
+    gp_Vec* d = buffer;
+    if (n > MaxDegree() + 1)
+    {
+        heap.resize(n + 1);
+        d = heap.data();
+    }
+    Evaluate(u, n, d);
+    return d[n];
 }
 
-const gp_Pnt& Geom_BezierCurve::Pole(const int index) const
+void Geom_BezierCurve::Derivatives(const double u, const int n, gp_Vec* d) const
 {
-    // Check index
-    VALIDATE_ARGUMENT_RANGE(index, 0, Degree());
+    VALIDATE_ARGUMENT(n < 0, "n", "Geom_BezierCurve: Derivative order must not be negative!");
 
-    return m_poles[index];
+    Evaluate(u, n, d);
 }
 
-double Geom_BezierCurve::Weight(const int index) const
+void Geom_BezierCurve::D0Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p) const
 {
-    // Check index
-    VALIDATE_ARGUMENT_RANGE(index, 0, Degree());
+    EvaluateBatch(params, nbParams, 0, &p);
+}
 
-    if(IsRational())
+void Geom_BezierCurve::D1Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const
+{
+    const gp_SoAOfXYZ d[2] = {p, v1};
+    EvaluateBatch(params, nbParams, 1, d);
+}
+
+void Geom_BezierCurve::D2Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1, const gp_SoAOfXYZ& v2) const
+{
+    const gp_SoAOfXYZ d[3] = {p, v1, v2};
+    EvaluateBatch(params, nbParams, 2, d);
+}
+
+void Geom_BezierCurve::Evaluate(const double u, const int nbDeriv, gp_Vec* d) const
+{
+    const int degree = Degree();
+    if (nbDeriv <= Geom_BezierEvaluator::MaxNbDeriv)
+    {
+        // Evaluator specialized for the degree, selected when the degree or the rationality changed.
+        gp_Pnt4d a[Geom_BezierEvaluator::MaxNbDeriv + 1];
+        m_evaluator[nbDeriv](EvaluatorInput(), u, a);
+        if (IsRational())
+        {
+            Geom_BezierKernel::RationalDerivatives(a, nbDeriv, d);
+        }
+        else
+        {
+            for (int k = 0; k <= nbDeriv; ++k)
+            {
+                d[k] = gp_Vec(a[k]);
+            }
+        }
+        return;
+    }
+
+    // Homogeneous derivatives, on the stack for the orders a curve can have without vanishing.
+    gp_Pnt4d buffer[MaxDegree() + 2];
+    std::vector<gp_Pnt4d> heap;
+    gp_Pnt4d* a = buffer;
+    if (nbDeriv > MaxDegree() + 1)
     {
-        return m_weights[index];
+        heap.resize(nbDeriv + 1);
+        a = heap.data();
+    }
+
+    // The derivative of order k is a point of the hodograph of degree (degree - k).
+    const HodographPoles& hodographs = Hodographs();
+    std::fill(a, a + nbDeriv + 1, gp_Pnt4d(0.0));
+    for (int k = 0; k <= std::min(nbDeriv, degree); ++k)
+    {
+        Geom_BezierKernel::Casteljau(hodographs.Poles(k), degree - k, u, 0, &a[k]);
+    }
+
+    if (IsRational())
+    {
+        Geom_BezierKernel::RationalDerivatives(a, nbDeriv, d);
     }
     else
     {
-        return 1.0;
+        for (int k = 0; k <= nbDeriv; ++k)
+        {
+            d[k] = gp_Vec(a[k]);
+        }
     }
 }
 
-void Geom_BezierCurve::Weights(std_Array1OfReal& weights) const
+Geom_BezierEvaluator::Input Geom_BezierCurve::EvaluatorInput() const
 {
-    if(IsRational())
+    Geom_BezierEvaluator::Input input = {};
+    if (IsRational())
     {
-        weights = m_weights;
+        input.hpoles = m_data->WPoles();
     }
     else
     {
-        for(int i = 0; i < Degree(); ++i)
+        input.poles = m_data->Poles();
+    }
+    return input;
+}
+
+void Geom_BezierCurve::EvaluateBatch(const double* params, const int nbParams, const int nbDeriv, const gp_SoAOfXYZ* d) const
+{
+    Geom_BezierKernel::Poles poles;
+    TransposedPoles(poles);
+
+    // The conversion costs about one de Casteljau evaluation, it is repaid from the second parameter
+    // of the batch on, and is not kept: the curve stores no power basis.
+    if (Geom_BezierEvaluator::UsesMonomials(Degree()) && nbParams > 1)
+    {
+        Geom_BezierKernel::Monomials monomials;
+        Geom_BezierKernel::ToMonomials(poles, monomials);
+        Geom_BezierKernel::EvaluateBatch(monomials, params, nbParams, nbDeriv, d);
+        return;
+    }
+
+    Geom_BezierKernel::EvaluateBatch(poles, params, nbParams, nbDeriv, d);
+}
+
+void Geom_BezierCurve::D0Uniform(const double first, const double last, const int nbPoints, const int anchorInterval, const gp_SoAOfXYZ& p) const
+{
+    EvaluateUniform(first, last, nbPoints, anchorInterval, 0, &p);
+}
+
+void Geom_BezierCurve::D1Uniform(const double first, const double last, const int nbPoints, const int anchorInterval, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const
+{
+    const gp_SoAOfXYZ d[2] = {p, v1};
+    EvaluateUniform(first, last, nbPoints, anchorInterval, 1, d);
+}
+
+double Geom_BezierCurve::UniformError(const int anchorInterval) const
+{
+    VALIDATE_ARGUMENT(anchorInterval < 1, "anchorInterval", "Geom_BezierCurve: Anchor interval must be at least 1!");
+
+    // Scale of the coordinates of the stepped homogeneous curve A. For a rational curve, the errors of
+    // A and of the weight w both reach the point C = A / w: (|dA| + |C| |dw|) / w.
+    const int degree = Degree();
+    double maxCoordinate = 0.0, maxPole = 0.0;
+    double minWeight = 1.0, maxWeight = 1.0;
+    for (int j = 0; j <= degree; ++j)
+    {
+        const gp_Pnt4d pole = IsRational() ? m_data->WPoles()[j] : gp_Pnt4d(m_data->Poles()[j], 1.0);
+        for (int c = 0; c < 3; ++c)
         {
-            weights[i] = 1.0;
+            maxCoordinate = std::max(maxCoordinate, std::abs(pole[c]));
+            maxPole = std::max(maxPole, std::abs(m_data->Poles()[j][c]));
         }
+        minWeight = std::min(minWeight, pole.w);
+        maxWeight = std::max(maxWeight, pole.w);
     }
+    const double scale = IsRational() ? (maxCoordinate + maxPole * maxWeight) / minWeight : maxCoordinate;
+
+    // Sum(k = 0..n) Binomial(m, k) * 2^k for the last point before the next anchor.
+    const double m = anchorInterval - 1;
+    double binomial = 1.0, power = 1.0, sum = 1.0;
+    for (int k = 1; k <= std::min(degree, anchorInterval - 1); ++k)
+    {
+        binomial = binomial * (m - k + 1) / k;
+        power *= 2.0;
+        sum += binomial * power;
+    }
+    // The values at the anchor carry errors of about n eps M.
+    return std::numeric_limits<double>::epsilon() * scale * degree * sum;
 }
 
-std_Array1OfReal Geom_BezierCurve::Weights() const
+// Replaces the values of a polynomial of the given degree at u + j * step, j = 0..degree,
+// by its forward differences of order j at u.
+static void ForwardDifferences(gp_Pnt4d* values, const int degree)
 {
-    if(IsRational())
+    for (int k = 1; k <= degree; ++k)
     {
-        return m_weights;
+        for (int j = degree; j >= k; --j)
+        {
+            values[j] -= values[j - 1];
+        }
     }
-    else
+}
+
+void Geom_BezierCurve::EvaluateUniform(const double first, const double last, const int nbPoints, const int anchorInterval,
+                                       const int nbDeriv, const gp_SoAOfXYZ* d) const
+{
+    VALIDATE_ARGUMENT(nbPoints < 2, "nbPoints", "Geom_BezierCurve: At least 2 points must be sampled!");
+    VALIDATE_ARGUMENT(anchorInterval < 1, "anchorInterval", "Geom_BezierCurve: Anchor interval must be at least 1!");
+
+    const int degree = Degree();
+    const double step = (last - first) / (nbPoints - 1);
+    const Geom_BezierEvaluator::Input input = EvaluatorInput();
+    const Geom_BezierEvaluator::Stepper stepper = Geom_BezierEvaluator::SelectStepper(degree, IsRational(), nbDeriv);
+
+    // The point is stepped on the homogeneous curve, the first derivative on its first hodograph.
+    for (int anchor = 0; anchor < nbPoints; anchor += anchorInterval)
+    {
+        // Anchors are computed from the index so that the parameters do not drift either.
+        const double u = first + anchor * step;
+        gp_Pnt4d point[MaxDegree() + 1], derivative[MaxDegree() + 1];
+        for (int j = 0; j <= degree; ++j)
+        {
+            gp_Pnt4d a[2];
+            m_evaluator[nbDeriv](input, u + j * step, a);
+            point[j] = a[0];
+            if (nbDeriv >= 1)
+            {
+                derivative[j] = a[1];
+            }
+        }
+        ForwardDifferences(point, degree);
+        if (nbDeriv >= 1)
+        {
+            ForwardDifferences(derivative, degree - 1);
+        }
+
+        stepper(point, derivative, anchor, std::min(anchorInterval, nbPoints - anchor), d);
+    }
+}
+
+void Geom_BezierCurve::TransposedPoles(Geom_BezierKernel::Poles& poles) const
+{
+    poles.degree = Degree();
+    poles.rational = IsRational();
+    for (int j = 0; j <= poles.degree; ++j)
+    {
+        const gp_Pnt4d p = poles.rational ? m_data->WPoles()[j] : gp_Pnt4d(m_data->Poles()[j], 1.0);
+        poles.x[j] = p.x;
+        poles.y[j] = p.y;
+        poles.z[j] = p.z;
+        poles.w[j] = p.w;
+    }
+}
+
+void* Geom_BezierCurve::HodographPoles::operator new(const size_t size, const int degree)
+{
+    return ::operator new(size + (degree + 1) * (degree + 2) / 2 * sizeof(gp_Pnt4d));
+}
+
+void Geom_BezierCurve::HodographPoles::operator delete(void* memory)
+{
+    ::operator delete(memory);
+}
+
+void Geom_BezierCurve::HodographPoles::operator delete(void* memory, const int /*degree*/)
+{
+    ::operator delete(memory);
+}
+
+const Geom_BezierCurve::HodographPoles& Geom_BezierCurve::Hodographs() const
+{
+    const HodographPoles* hodographs = m_data->hodographs.load(std::memory_order_acquire);
+    if (hodographs)
+    {
+        return *hodographs;
+    }
+
+    const int degree = Degree();
+    HodographPoles* built = new (degree) HodographPoles{degree};
+    gp_Pnt4d* poles = built->Poles(0);
+    for (int j = 0; j <= degree; ++j)
     {
-        std_Array1OfReal weights(NbPoles());
-        for(int i = 0; i < Degree(); ++i)
+        poles[j] = IsRational() ? m_data->WPoles()[j] : gp_Pnt4d(m_data->Poles()[j], 1.0);
+    }
+
+    // Each order differentiates the previous one.
+    for (int k = 1; k <= degree; ++k)
+    {
+        const gp_Pnt4d* previous = built->Poles(k - 1);
+        gp_Pnt4d* current = built->Poles(k);
+        const double factor = degree - k + 1;
+        for (int j = 0; j <= degree - k; ++j)
+        {
+            current[j] = factor * (previous[j + 1] - previous[j]);
+        }
+    }
+
+    return Publish(m_data->hodographs, built);
+}
+
+double Geom_BezierCurve::MaxSpeed() const
+{
+    // The first hodograph, of poles degree * (P[j + 1] - P[j]), bounds the speed by the convex hull property.
+    const int degree = Degree();
+    const gp_Pnt* poles = m_data->Poles();
+    double maxSpeed = 0.0;
+    if (!IsRational())
+    {
+        for (int j = 0; j < degree; ++j)
+        {
+            maxSpeed = std::max(maxSpeed, degree * glm::distance(poles[j + 1], poles[j]));
+        }
+        return maxSpeed;
+    }
+
+    // C' = (A' - w' C) / w where A is the homogeneous curve. Around the centroid q of the poles,
+    // |A' - w' q| is bounded by the first hodograph of A - w q and |C - q| by the farthest pole.
+    const gp_Pnt4d* wpoles = m_data->WPoles();
+    gp_Pnt q(0.0);
+    for (int j = 0; j <= degree; ++j)
+    {
+        q += poles[j];
+    }
+    q /= double(NbPoles());
+
+    double radius = 0.0;
+    double minWeight = wpoles[0].w;
+    for (int j = 0; j <= degree; ++j)
+    {
+        radius = std::max(radius, glm::distance(poles[j], q));
+        minWeight = std::min(minWeight, wpoles[j].w);
+    }
+
+    double speed = 0.0, weightSpeed = 0.0;
+    for (int j = 0; j < degree; ++j)
+    {
+        const gp_Pnt4d first = double(degree) * (wpoles[j + 1] - wpoles[j]);
+        speed = std::max(speed, glm::length(gp_Vec(first) - first.w * q));
+        weightSpeed = std::max(weightSpeed, std::abs(first.w));
+    }
+    return (speed + weightSpeed * radius) / minWeight;
+}
+
+Geom_BezierCurve::Data& Geom_BezierCurve::MutableData()
+{
+    return MutableData(NbPoles(), IsRational());
+}
+
+Geom_BezierCurve::Data& Geom_BezierCurve::MutableData(const int nbPoles, const bool rational)
+{
+    // Shared or resized poles are copied into a new block without their caches, otherwise the caches are discarded.
+    // The new block comes from the default resource: the resource of a curve may not outlive its copies,
+    // nor be usable by the thread modifying one of them.
+    if (m_data.IsShared() || nbPoles != NbPoles() || rational != IsRational())
+    {
+        DataRef data(Data::Create(std::pmr::get_default_resource(), nbPoles, rational));
+        const int nbKept = std::min(nbPoles, NbPoles());
+        std::copy(m_data->Poles(), m_data->Poles() + nbKept, data->Poles());
+        if (rational && IsRational())
         {
-            weights[i] = 1.0;
+            std::copy(m_data->WPoles(), m_data->WPoles() + nbKept, data->WPoles());
         }
-        return weights;
+        m_data = data;
     }
+    else
+    {
+        m_data->Invalidate();
+    }
+    return *m_data;
+}
+
+const gp_Pnt& Geom_BezierCurve::Pole(const int index) const
+{
+    // Check index
+    VALIDATE_ARGUMENT_RANGE(index, 0, Degree());
+
+    return m_data->Poles()[index];
+}
+
+double Geom_BezierCurve::Weight(const int index) const
+{
+    // Check index
+    VALIDATE_ARGUMENT_RANGE(index, 0, Degree());
+
+    if(IsRational())
+    {
+        return m_data->WPoles()[index].w;
+    }
+    else
+    {
+        return 1.0;
+    }
+}
+
+void Geom_BezierCurve::Weights(std_Array1OfReal& weights) const
+{
+    weights.resize(NbPoles());
+    for(int i = 0; i < NbPoles(); ++i)
+    {
+        weights[i] = IsRational() ? m_data->WPoles()[i].w : 1.0;
+    }
+}
+
+std_Array1OfReal Geom_BezierCurve::Weights() const
+{
+    std_Array1OfReal weights;
+    Weights(weights);
+    return weights;
+}
+
+void Geom_BezierCurve::Resolution(const double tolerance3D, double& uTolerance) const
+{
+    VALIDATE_ARGUMENT(tolerance3D <= 0.0, "tolerance3D", "Geom_BezierCurve: Tolerance must be positive!");
+
+    // |f(t1) - f(t0)| <= maxSpeed * |t1 - t0|, on a parameter range of length 1.
+    const double maxSpeed = MaxSpeed();
+    uTolerance = (maxSpeed > tolerance3D) ? tolerance3D / maxSpeed : 1.0;
+}
+
+handle<Geom_Curve> Geom_BezierCurve::Copy() const
+{
+    return std::make_shared<Geom_BezierCurve>(*this);
 }
\ No newline at end of file
@@ -1,12 +1,17 @@
 // Describes a rational or non-rational Bezier curve
 // - a non-rational Bezier curve is defined by a table of poles (also called control points),
 // - a rational Bezier curve is defined by a table of poles with varying weights.
-// The weights are defined and used only in the case of a rational curve.
+// The weights are defined and used only in the case of a rational curve, they are stored
+// with the poles in homogeneous coordinates so that the evaluation runs a single 4D pass.
 
 #ifndef GEOM_BEZIERCURVE_H
 #define GEOM_BEZIERCURVE_H
 
 #include "geom_BoundedCurve.h"
+#include "geom_BezierEvaluator.h"
+
+#include <atomic>
+#include <memory_resource>
 
 class Geom_BezierCurve: public Geom_BoundedCurve
 {
@@ -23,17 +28,46 @@ public:
     // or lower than 2 or curvePoles and curveWeights don't have the same length.
     Geom_BezierCurve(const gp_Array1OfPnt& poles, const std_Array1OfReal& weights);
 
-    // Increases the degree of a bezier curve.
-    // Raised if new degree is greater than MaxDegree or lower than 2 or lower than the initial degree.
-    void Increase(const double degree);
+    // Creates the Bezier curve of the nbPoles poles and weights, null for a non-rational curve, whose poles
+    // are allocated from the resource. Only this construction uses the resource: the copies of the curve share
+    // its poles, and a modification which copies them allocates the copy from the default resource.
+    // If all the weights are identical the curve is considered as non rational.
+    // Raised if nbPoles is greater than MaxDegree + 1 or lower than 2, if a weight is near zero or if resource is null.
+    Geom_BezierCurve(const gp_Pnt* poles, const int nbPoles, const double* weights, std::pmr::memory_resource* resource);
+
+    // Returns the curve of the nbPoles poles and weights, allocated with its control block and its poles from the
+    // resource: two allocations per curve, and none from the heap until its evaluation caches are built.
+    // With a std::pmr::monotonic_buffer_resource the deallocations are free and the memory of a whole model
+    // is released at once with the resource, which must outlive the curves and their copies, as these share
+    // the poles. Only Make() allocates from the resource: Copy(), the caches and the poles copied on a
+    // modification come from the default resource, so that a resource used by a single thread is never used
+    // by concurrent readers. The poles are returned to the resource by the curve releasing them last, which
+    // costs nothing with a std::pmr::monotonic_buffer_resource; other unsynchronized resources require the
+    // curves to be released by the thread owning the resource.
+    // Raised as the constructor.
+    static handle<Geom_BezierCurve> Make(std::pmr::memory_resource* resource, const gp_Pnt* poles, const int nbPoles,
+                                         const double* weights);
+
+    // Increases the degree of a bezier curve, in one pass for any number of degrees.
+    // A rational curve is elevated in homogeneous coordinates.
+    // Raised if new degree is greater than MaxDegree or lower than the initial degree.
+    void Increase(const int degree);
 
     // Segments the curve between u1 and u2 which must be in the bounds of the curve.
     // The curve is oriented from u1 to u2.
     // Warnings:
     // Even if the curve is not closed it can become closed after the segmentation
     // for example if the curve makes loop.
+    // The poles are the blossom values of the bounds, computed in place in O(Degree()^2).
+    // Raised if u1 or u2 is out of [0, 1] or if they are equal.
     void Segment(const double u1, const double u2);
 
+    // Splits the curve at the nbParams parameters params, strictly increasing in ]0, 1[, into nbParams + 1 curves.
+    // The poles of the curve i are stored in poles[i * (Degree() + 1)], ..., poles[(i + 1) * (Degree() + 1) - 1]
+    // and, if weights is not null, their weights in weights at the same indices.
+    // Each cut subdivides the rest of the curve once.
+    void SplitAt(const double* params, const int nbParams, gp_Pnt* poles, double* weights) const;
+
     // Substitutes the pole of range index with p.
     // Raised if the index is not in the range [0, m_NbPoles - 1].
     void SetPole(const int index, const gp_Pnt& p);
@@ -56,6 +90,38 @@ public:
 
     gp_Vec DN(const double u, const int n) const override;
 
+    // Computes the point d[0] and the derivatives d[1], ..., d[n] of parameter u from a single evaluation
+    // of the basis, the derivatives of a rational curve follow from the Leibniz rule.
+    void Derivatives(const double u, const int n, gp_Vec* d) const override;
+
+    // Batch evaluations of blocks of parameters sharing the setup of the poles.
+    void D0Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p) const override;
+
+    void D1Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const override;
+
+    void D2Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1, const gp_SoAOfXYZ& v2) const override;
+
+    // Computes the points of the nbPoints parameters first + i * (last - first) / (nbPoints - 1) and stores them in p.
+    // The points follow by forward differencing, Degree() additions per coordinate and per point, and the
+    // differences are recomputed from the poles every anchorInterval points to bound the drift,
+    // see UniformError(). An anchorInterval of 1 evaluates every point directly.
+    // Raised if nbPoints < 2 or anchorInterval < 1.
+    void D0Uniform(const double first, const double last, const int nbPoints, const int anchorInterval, const gp_SoAOfXYZ& p) const;
+
+    // Computes the points and the first derivatives of the uniform parameters, see D0Uniform().
+    void D1Uniform(const double first, const double last, const int nbPoints, const int anchorInterval, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const;
+
+    // Returns an estimate of the largest distance between a point of D0Uniform() and the point of D0
+    // of the same parameter, for points up to anchorInterval steps away from an anchor.
+    // The differences of order k computed at an anchor from values of error n eps M have errors of
+    // about 2^k n eps M, which reach the point after m steps multiplied by Binomial(m, k), hence
+    //   error(m) ~ n * eps * M * Sum(k = 0..n) Binomial(m, k) * 2^k,
+    // where eps is the machine epsilon, n the degree and M the largest coordinate of the poles. For a rational
+    // curve, M = (max |w P| + max |P| max w) / min w as the errors on the weight reach the point too.
+    // The error of the first derivatives is of the same order. For a cubic, error(64) ~ 3e5 eps M,
+    // for the degree 13, error(32) ~ 2e12 eps M: high degrees need short intervals.
+    double UniformError(const int anchorInterval) const;
+
     // Returns true if the distance between the first point
     // and the last point of the curve is not more than the
     // Resolution from package goemetry.
@@ -73,7 +139,7 @@ public:
     // Returns false if all the weights are identical. The tolerance criterion is Resolution from geometry package.
     inline bool IsRational() const
     {
-        return (m_weights.size() != 0);
+        return m_data->rational;
     }
 
     // a Bezier curve is CN
@@ -91,13 +157,13 @@ public:
     // Returns Value (u=0), it is the first control point of the curve.
     inline gp_Pnt StartPoint() const override
     {
-        return m_poles[0];
+        return m_data->Poles()[0];
     }
 
     // Returns Value (u=1), it is the last control point of the curve.
     inline gp_Pnt EndPoint() const override
     {
-        return m_poles[Degree()];
+        return m_data->Poles()[Degree()];
     }
     
     // This is 0.0, which gives the start point of this Bezier curve.
@@ -115,7 +181,7 @@ public:
     // Returns the number of poles of this Bezier curve.
     inline int NbPoles() const
     {
-        return m_poles.size();
+        return m_data->nbPoles;
     }
 
     // Returns the pole of range index.
@@ -125,13 +191,20 @@ public:
     // Returns all the poles of the curve.
     inline void Poles(gp_Array1OfPnt& p) const
     {
-        p = m_poles;
+        p.assign(m_data->Poles(), m_data->Poles() + NbPoles());
     }
 
-    // Returns all the poles of the curve.
-    inline const gp_Array1OfPnt& Poles() const
+    // Returns a copy of all the poles of the curve.
+    // The poles are not stored in a gp_Array1OfPnt, PolesData() reads them in place.
+    inline gp_Array1OfPnt Poles() const
+    {
+        return gp_Array1OfPnt(m_data->Poles(), m_data->Poles() + NbPoles());
+    }
+
+    // Returns the NbPoles() poles of the curve, valid until the curve is modified or destroyed.
+    inline const gp_Pnt* PolesData() const
     {
-        return m_poles;
+        return m_data->Poles();
     }
 
     // Returns the weight of range index.
@@ -145,7 +218,7 @@ public:
 
     // Returns the value of the maximum polynomial degree of
     // any Geom_BezierCurve curve. This value is 25.
-    inline static int MaxDegree()
+    constexpr static int MaxDegree()
     {
         return 25;
     }
@@ -154,21 +227,165 @@ public:
     // If f(t) is the equation of this Bezier curve,
     // uTolerance ensures that:
     // |t1-t0| < uTolerance ===> |f(t1)-f(t0)| < tolerance3D
-    void Resolution(const double tolerance3D, double& uTolerance);
+    // The bound of the speed follows from the first hodograph, in O(Degree()) without building the others.
+    void Resolution(const double tolerance3D, double& uTolerance) const;
 
     // Creates a new object which is a copy of this Bezier curve.
+    // The copy shares the poles and the evaluation caches with this curve until one of them is modified,
+    // it is allocated from the default resource, never from the resource of this curve.
     handle<Geom_Curve> Copy() const override;
 
 private:
     // Set poles and weights. If weights is null the curve is non-rational
     // and weights are assumed to have the first coefficient 1.
-    // Update rational and closed.
-    void Init(const gp_Array1OfPnt& poles, const std_Array1OfReal& weights);
+    // Update rational and closed. The poles are allocated from the resource.
+    void Init(const gp_Pnt* poles, const int nbPoles, const double* weights, std::pmr::memory_resource* resource);
+
+    // Computes the point d[0] and the derivatives d[1], ..., d[nbDeriv] of the parameter u.
+    // Orders up to Geom_BezierEvaluator::MaxNbDeriv go through the evaluators specialized for the degree,
+    // higher orders through the cached hodographs.
+    void Evaluate(const double u, const int nbDeriv, gp_Vec* d) const;
+
+    // Computes the points and the derivatives up to nbDeriv (<= 2) of a batch of parameters into d[0..nbDeriv].
+    // Degrees up to Geom_BezierKernel::MaxMonomialDegree convert the poles to the power basis for the batch.
+    void EvaluateBatch(const double* params, const int nbParams, const int nbDeriv, const gp_SoAOfXYZ* d) const;
+
+    // Returns the coefficients read by the evaluators specialized for the degree.
+    Geom_BezierEvaluator::Input EvaluatorInput() const;
+
+    // Computes the points and the derivatives up to nbDeriv (<= 1) of uniform parameters by forward differencing.
+    void EvaluateUniform(const double first, const double last, const int nbPoints, const int anchorInterval,
+                         const int nbDeriv, const gp_SoAOfXYZ* d) const;
+
+    // Transposes the poles into rows of coordinates, homogeneous for a rational curve.
+    void TransposedPoles(Geom_BezierKernel::Poles& poles) const;
+
+    // Control polygons of the derivatives of the homogeneous curve: the derivative of order k is the
+    // Bezier curve of degree (degree - k) whose poles are the k-th differences of the poles
+    // scaled by degree! / (degree - k)!. The w coordinates vanish for a non-rational curve.
+    // The (degree + 1) (degree + 2) / 2 poles of all the orders follow the header in a single allocation,
+    // new (degree) HodographPoles{degree}.
+    struct alignas(gp_Pnt4d) HodographPoles
+    {
+        int degree;
+
+        // Returns the degree - k + 1 poles of order k, for k in [0, degree].
+        inline gp_Pnt4d* Poles(const int k) const
+        {
+            return reinterpret_cast<gp_Pnt4d*>(const_cast<HodographPoles*>(this) + 1) + k * (degree + 1) - k * (k - 1) / 2;
+        }
+
+        static void* operator new(const size_t size, const int degree);
+        static void operator delete(void* memory);
+        static void operator delete(void* memory, const int degree);
+    };
+
+    // Returns the hodographs, built on first use after a modification.
+    // Concurrent calls are safe, they only race to publish identical poles.
+    const HodographPoles& Hodographs() const;
+
+    // Returns an upper bound of the norm of the first derivative of the curve, from its first hodograph.
+    double MaxSpeed() const;
+
+    // Poles and caches derived from them, shared by the copies of a curve.
+    // A block is allocated once with room for its poles, followed by the homogeneous poles
+    // (w*x, w*y, w*z, w) of a rational curve: the evaluation only reads these for a rational curve.
+    struct Data
+    {
+        Data(std::pmr::memory_resource* resource, const int nbPoles, const bool rational);
+
+        ~Data();
+
+        // Returns a block of nbPoles poles, with homogeneous poles if rational, allocated from the resource.
+        // The poles are not initialized.
+        static Data* Create(std::pmr::memory_resource* resource, const int nbPoles, const bool rational);
+
+        // Releases a reference to the block, which is destroyed and deallocated with the last one.
+        static void Release(Data* data);
+
+        inline gp_Pnt* Poles() const
+        {
+            return reinterpret_cast<gp_Pnt*>(const_cast<Data*>(this) + 1);
+        }
+
+        inline gp_Pnt4d* WPoles() const
+        {
+            return reinterpret_cast<gp_Pnt4d*>(Poles() + nbPoles);
+        }
+
+        // Discards the caches.
+        void Invalidate();
+
+        std::atomic<int> refCount;
+        const int nbPoles;
+        const bool rational;
+        std::pmr::memory_resource* const resource;
+
+        mutable std::atomic<const HodographPoles*> hodographs{nullptr};
+    };
+
+    // Counted reference to a block, copying a curve only shares its block.
+    class DataRef
+    {
+    public:
+        explicit DataRef(Data* data = nullptr) : m_ptr(data)
+        {
+        }
+
+        DataRef(const DataRef& other) : m_ptr(other.m_ptr)
+        {
+            if (m_ptr)
+            {
+                m_ptr->refCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        DataRef& operator=(const DataRef& other)
+        {
+            DataRef copy(other);
+            std::swap(m_ptr, copy.m_ptr);
+            return *this;
+        }
+
+        ~DataRef()
+        {
+            Data::Release(m_ptr);
+        }
+
+        inline Data* operator->() const
+        {
+            return m_ptr;
+        }
+
+        inline Data& operator*() const
+        {
+            return *m_ptr;
+        }
+
+        // Returns true if another curve shares the block.
+        inline bool IsShared() const
+        {
+            return m_ptr->refCount.load(std::memory_order_acquire) > 1;
+        }
+
+    private:
+        Data* m_ptr;
+    };
+
+    // Returns the poles for a modification: they are copied first if another curve shares them,
+    // and their caches are discarded.
+    // Must be called by every modification of the poles or weights.
+    Data& MutableData();
+
+    // Same as above for a modification which changes the number of poles or the rationality.
+    // The block is replaced by one of nbPoles poles, with homogeneous poles if rational, holding the first
+    // poles of the current one; the homogeneous poles are only kept if both blocks are rational.
+    Data& MutableData(const int nbPoles, const bool rational);
 
 private:
     bool m_closed;
-    gp_Array1OfPnt m_poles;
-    std_Array1OfReal m_weights;
+    const Geom_BezierEvaluator::Function* m_evaluator;
+    DataRef m_data;
 };
 
 #endif
\ No newline at end of file
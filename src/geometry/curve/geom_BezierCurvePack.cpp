@@ -0,0 +1,122 @@
+#include "geom_BezierCurvePack.h"
+#include "exceptions.h"
+
+#include <algorithm>
+#include <numeric>
+
+Geom_BezierCurvePack::Geom_BezierCurvePack(const Geom_BezierCurveSet& set)
+{
+    Init(set, 1);
+}
+
+Geom_BezierCurvePack::Geom_BezierCurvePack(const Geom_BezierCurveSet& set, const int degree)
+{
+    VALIDATE_ARGUMENT(degree > Geom_BezierCurve::MaxDegree(), "degree", "Geom_BezierCurvePack: Degree is greater than MaxDegree()!");
+    for (int i = 0; i < set.NbCurves(); ++i)
+    {
+        VALIDATE_ARGUMENT(set.Degree(i) > degree, "degree", "Geom_BezierCurvePack: Degree is lower than the degree of a curve!");
+    }
+
+    Init(set, degree);
+}
+
+void Geom_BezierCurvePack::Init(const Geom_BezierCurveSet& set, const int minDegree)
+{
+    constexpr int Width = Geom_BezierKernel::PackWidth;
+
+    // Sort the curves so that the packs mix as few degrees as possible.
+    std::vector<int> order(set.NbCurves());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&set](const int a, const int b)
+    {
+        if (set.IsRational(a) != set.IsRational(b))
+        {
+            return !set.IsRational(a);
+        }
+        return set.Degree(a) < set.Degree(b);
+    });
+
+    const int nbPacks = (set.NbCurves() + Width - 1) / Width;
+    m_offsets.resize(nbPacks);
+    m_degrees.resize(nbPacks);
+    m_rational.resize(nbPacks);
+    m_curves.assign(nbPacks * Width, -1);
+    m_poles.clear();
+
+    for (int pack = 0; pack < nbPacks; ++pack)
+    {
+        const int first = pack * Width;
+        const int count = std::min(Width, set.NbCurves() - first);
+
+        int degree = minDegree;
+        bool rational = false;
+        for (int l = 0; l < count; ++l)
+        {
+            degree = std::max(degree, set.Degree(order[first + l]));
+            rational = rational || set.IsRational(order[first + l]);
+        }
+
+        const int dim = rational ? 4 : 3;
+        m_offsets[pack] = static_cast<int>(m_poles.size());
+        m_degrees[pack] = degree;
+        m_rational[pack] = rational;
+        m_poles.resize(m_poles.size() + (degree + 1) * dim * Width);
+        double* poles = m_poles.data() + m_offsets[pack];
+
+        for (int l = 0; l < Width; ++l)
+        {
+            // The padding lanes repeat the last curve.
+            const int curve = order[first + std::min(l, count - 1)];
+            if (l < count)
+            {
+                m_curves[first + l] = curve;
+            }
+
+            // Elevate in homogeneous coordinates.
+            const Geom_BezierCurveView view = set.Curve(curve);
+            gp_Pnt4d hpoles[Geom_BezierKernel::MaxNbPoles];
+            for (int j = 0; j <= view.Degree(); ++j)
+            {
+                hpoles[j] = gp_Pnt4d(view.Weight(j) * view.Pole(j), view.Weight(j));
+            }
+            if (view.Degree() < degree)
+            {
+                Geom_BezierKernel::Elevate(hpoles, view.Degree(), degree);
+            }
+
+            for (int j = 0; j <= degree; ++j)
+            {
+                for (int c = 0; c < dim; ++c)
+                {
+                    poles[(j * dim + c) * Width + l] = hpoles[j][c];
+                }
+            }
+        }
+    }
+}
+
+void Geom_BezierCurvePack::D0(const double u, const gp_SoAOfXYZ& p) const
+{
+    Evaluate(u, 0, &p);
+}
+
+void Geom_BezierCurvePack::D1(const double u, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const
+{
+    const gp_SoAOfXYZ d[2] = {p, v1};
+    Evaluate(u, 1, d);
+}
+
+void Geom_BezierCurvePack::D2(const double u, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1, const gp_SoAOfXYZ& v2) const
+{
+    const gp_SoAOfXYZ d[3] = {p, v1, v2};
+    Evaluate(u, 2, d);
+}
+
+void Geom_BezierCurvePack::Evaluate(const double u, const int nbDeriv, const gp_SoAOfXYZ* d) const
+{
+    for (int pack = 0; pack < NbPacks(); ++pack)
+    {
+        Geom_BezierKernel::EvaluatePack(m_poles.data() + m_offsets[pack], m_degrees[pack], m_rational[pack],
+                                        u, nbDeriv, d, pack * Geom_BezierKernel::PackWidth);
+    }
+}
@@ -0,0 +1,77 @@
+// Bezier curves regrouped for the evaluation of many curves at the same parameter.
+// The curves are sorted by rationality and degree and packed by Geom_BezierKernel::PackWidth:
+// the poles of the curves of a pack are interleaved lane by lane (array of structures of arrays),
+// so that one instruction evaluates the same pole level of 2, 4 or 8 curves.
+// The curves of a pack are elevated to the highest degree of the pack, and the lanes of the last
+// pack not filled by a curve repeat the last curve.
+
+#ifndef GEOM_BEZIERCURVEPACK_H
+#define GEOM_BEZIERCURVEPACK_H
+
+#include "geom_BezierCurveSet.h"
+
+class Geom_BezierCurvePack
+{
+public:
+    // Packs the curves of the set, the curves of a pack are elevated to its highest degree.
+    explicit Geom_BezierCurvePack(const Geom_BezierCurveSet& set);
+
+    // Packs the curves of the set elevated to the common degree, e.g. the rails of a loft.
+    // Raised if degree is greater than Geom_BezierCurve::MaxDegree() or lower than the degree of a curve.
+    Geom_BezierCurvePack(const Geom_BezierCurveSet& set, const int degree);
+
+    // Returns the number of packs.
+    inline int NbPacks() const
+    {
+        return static_cast<int>(m_degrees.size());
+    }
+
+    // Returns the number of lanes, NbPacks() * Geom_BezierKernel::PackWidth.
+    inline int NbLanes() const
+    {
+        return static_cast<int>(m_curves.size());
+    }
+
+    // Returns the index in the set of the curve of a lane, -1 for a lane which only pads the last pack.
+    inline int Curve(const int lane) const
+    {
+        return m_curves[lane];
+    }
+
+    // Returns the degree of the curves of a pack.
+    inline int Degree(const int pack) const
+    {
+        return m_degrees[pack];
+    }
+
+    // Computes the points of all the curves at the parameter u and stores the point of the curve of each lane
+    // at the index of the lane. The buffers of p must hold NbLanes() values.
+    void D0(const double u, const gp_SoAOfXYZ& p) const;
+
+    // Computes the points and the first derivatives of all the curves at the parameter u, see D0.
+    void D1(const double u, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const;
+
+    // Computes the points, the first and second derivatives of all the curves at the parameter u, see D0.
+    void D2(const double u, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1, const gp_SoAOfXYZ& v2) const;
+
+private:
+    // Packs the curves of the set, elevated to at least minDegree.
+    void Init(const Geom_BezierCurveSet& set, const int minDegree);
+
+    // Evaluates all the packs at the parameter u up to the derivative nbDeriv.
+    void Evaluate(const double u, const int nbDeriv, const gp_SoAOfXYZ* d) const;
+
+private:
+    // Interleaved poles of the packs, see Geom_BezierKernel::EvaluatePack.
+    std::vector<double> m_poles;
+
+    // Per pack: offset in m_poles, degree and rationality.
+    std::vector<int> m_offsets;
+    std::vector<int> m_degrees;
+    std::vector<bool> m_rational;
+
+    // Per lane: index of the curve in the set, -1 for padding.
+    std::vector<int> m_curves;
+};
+
+#endif
@@ -0,0 +1,233 @@
+#include "geom_BezierCurveSet.h"
+#include "exceptions.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    // Number of poles in a chunk of the parallel decomposition, on average over the curves.
+    constexpr int GrainNbPoles = 1 << 12;
+}
+
+Geom_BezierCurveSet::Geom_BezierCurveSet()
+    : m_offsets(1, 0)
+{
+}
+
+void Geom_BezierCurveSet::Reserve(const int nbCurves, const int nbPoles)
+{
+    m_offsets.reserve(nbCurves + 1);
+    m_weightOffsets.reserve(nbCurves);
+    m_poles.reserve(nbPoles);
+}
+
+int Geom_BezierCurveSet::Append(const gp_Pnt* poles, const int nbPoles, const double* weights)
+{
+    // Check poles
+    VALIDATE_ARGUMENT(nbPoles < 2 || nbPoles > (Geom_BezierCurve::MaxDegree() + 1), "poles", "Geom_BezierCurveSet: Poles size is less than 2 or more than MaxDegree() + 1!");
+
+    // Check weights and rationality
+    bool rational = false;
+    if (weights)
+    {
+        for (int i = 0; i < nbPoles; ++i)
+        {
+            VALIDATE_ARGUMENT(weights[i] <= gp_Resolution, "weights", "Geom_BezierCurveSet: Weights values are too small!");
+            rational = rational || std::abs(weights[i] - weights[0]) > gp_Resolution;
+        }
+    }
+
+    m_poles.insert(m_poles.end(), poles, poles + nbPoles);
+    m_offsets.push_back(static_cast<int>(m_poles.size()));
+    if (rational)
+    {
+        m_weightOffsets.push_back(static_cast<int>(m_weights.size()));
+        m_weights.insert(m_weights.end(), weights, weights + nbPoles);
+    }
+    else
+    {
+        m_weightOffsets.push_back(-1);
+    }
+    return NbCurves() - 1;
+}
+
+int Geom_BezierCurveSet::Append(const Geom_BezierCurve& curve)
+{
+    double weights[Geom_BezierCurve::MaxDegree() + 1];
+    for (int i = 0; i < curve.NbPoles(); ++i)
+    {
+        weights[i] = curve.Weight(i);
+    }
+    return Append(curve.PolesData(), curve.NbPoles(), curve.IsRational() ? weights : nullptr);
+}
+
+int Geom_BezierCurveSet::Append(const Geom_BezierCurveView& curve)
+{
+    return Append(curve.Poles(), curve.NbPoles(), curve.Weights());
+}
+
+int Geom_BezierCurveSet::AppendBezierSegments(const handle<Geom_BSplineCurve>* curves, const int nbCurves)
+{
+    // Indices of the first segment, pole and weight of each curve, the last ones are the new sizes.
+    std::vector<int> segments(nbCurves + 1), poles(nbCurves + 1), weights(nbCurves + 1);
+    segments[0] = NbCurves();
+    poles[0] = NbPoles();
+    weights[0] = static_cast<int>(m_weights.size());
+    for (int i = 0; i < nbCurves; ++i)
+    {
+        const int nbSegments = curves[i]->NbBezierSegments();
+        const int nbPoles = nbSegments * (curves[i]->Degree() + 1);
+        segments[i + 1] = segments[i] + nbSegments;
+        poles[i + 1] = poles[i] + nbPoles;
+        weights[i + 1] = weights[i] + (curves[i]->IsRational() ? nbPoles : 0);
+    }
+
+    m_poles.resize(poles[nbCurves]);
+    m_weights.resize(weights[nbCurves]);
+    m_offsets.resize(segments[nbCurves] + 1);
+    m_weightOffsets.resize(segments[nbCurves]);
+
+    // Each curve writes its own ranges of the arrays.
+    auto decompose = [&](const int first, const int last)
+    {
+        for (int i = first; i < last; ++i)
+        {
+            const Geom_BSplineCurve& curve = *curves[i];
+            const int nbSegmentPoles = curve.Degree() + 1;
+            const bool rational = curve.IsRational();
+            curve.BezierSegments(m_poles.data() + poles[i], rational ? m_weights.data() + weights[i] : nullptr);
+            for (int k = 0; k < segments[i + 1] - segments[i]; ++k)
+            {
+                m_offsets[segments[i] + k + 1] = poles[i] + (k + 1) * nbSegmentPoles;
+                m_weightOffsets[segments[i] + k] = rational ? weights[i] + k * nbSegmentPoles : -1;
+            }
+        }
+    };
+
+    // The curves are handed out in chunks weighted by their mean number of poles.
+    const long long nbPoles = poles[nbCurves] - poles[0];
+    const int grain = static_cast<int>(std::max(1LL, GrainNbPoles * static_cast<long long>(nbCurves) / std::max(1LL, nbPoles)));
+    Parallel::For(nbCurves, grain, decompose);
+
+    return segments[0];
+}
+
+void Geom_BezierCurveSet::Clear()
+{
+    m_poles.clear();
+    m_weights.clear();
+    m_offsets.assign(1, 0);
+    m_weightOffsets.clear();
+}
+
+Geom_BezierCurveView Geom_BezierCurveSet::Curve(const int index) const
+{
+    VALIDATE_ARGUMENT_RANGE(index, 0, NbCurves() - 1);
+
+    const double* weights = IsRational(index) ? m_weights.data() + m_weightOffsets[index] : nullptr;
+    return Geom_BezierCurveView(m_poles.data() + m_offsets[index], weights, Degree(index));
+}
+
+void Geom_BezierCurveSet::D0Batch(const int* curves, const double* params, const int nbParams, const gp_SoAOfXYZ& p) const
+{
+    EvaluateBatch(curves, params, nbParams, 0, &p);
+}
+
+void Geom_BezierCurveSet::D1Batch(const int* curves, const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const
+{
+    const gp_SoAOfXYZ d[2] = {p, v1};
+    EvaluateBatch(curves, params, nbParams, 1, d);
+}
+
+void Geom_BezierCurveSet::BoundingBoxes(const gp_SoAOfXYZ& min, const gp_SoAOfXYZ& max) const
+{
+    // The poles are read in one sweep.
+    for (int i = 0; i < NbCurves(); ++i)
+    {
+        gp_Pnt low = m_poles[m_offsets[i]];
+        gp_Pnt high = low;
+        for (int j = m_offsets[i] + 1; j < m_offsets[i + 1]; ++j)
+        {
+            low = glm::min(low, m_poles[j]);
+            high = glm::max(high, m_poles[j]);
+        }
+        min.SetValue(i, low);
+        max.SetValue(i, high);
+    }
+}
+
+void Geom_BezierCurveSet::EvaluateBatch(const int* curves, const double* params, const int nbParams, const int nbDeriv, const gp_SoAOfXYZ* d) const
+{
+    if (nbParams == 0)
+    {
+        return;
+    }
+
+    // Unsorted curves are gathered in the stable order of their indices, with the parameters,
+    // and the results are written in buffers of the same order.
+    gp_SoAOfXYZ results[3];
+    std::copy(d, d + nbDeriv + 1, results);
+    std::vector<int> order, sortedCurves;
+    std::vector<double> buffer;
+    const bool sorted = std::is_sorted(curves, curves + nbParams);
+    if (!sorted)
+    {
+        order.resize(nbParams);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [curves](const int a, const int b) { return curves[a] < curves[b]; });
+
+        sortedCurves.resize(nbParams);
+        buffer.resize((1 + 3 * (nbDeriv + 1)) * static_cast<size_t>(nbParams));
+        for (int i = 0; i < nbParams; ++i)
+        {
+            sortedCurves[i] = curves[order[i]];
+            buffer[i] = params[order[i]];
+        }
+        for (int k = 0; k <= nbDeriv; ++k)
+        {
+            double* rows = buffer.data() + (1 + 3 * k) * static_cast<size_t>(nbParams);
+            results[k] = {rows, rows + nbParams, rows + 2 * nbParams};
+        }
+        curves = sortedCurves.data();
+        params = buffer.data();
+    }
+
+    // The indices are sorted, the bounds are the only ones to check.
+    VALIDATE_ARGUMENT(curves[0] < 0 || curves[nbParams - 1] >= NbCurves(), "curves", "Geom_BezierCurveSet: Curve index is out of range!");
+
+    // Each run of parameters of the same curve is one batch of the kernel on the transposed poles of the curve.
+    Geom_BezierKernel::Poles poles;
+    for (int first = 0; first < nbParams;)
+    {
+        const int index = curves[first];
+        int last = first + 1;
+        while (last < nbParams && curves[last] == index)
+        {
+            ++last;
+        }
+
+        const double* weights = IsRational(index) ? m_weights.data() + m_weightOffsets[index] : nullptr;
+        Geom_BezierCurveView(m_poles.data() + m_offsets[index], weights, Degree(index)).TransposedPoles(poles);
+
+        gp_SoAOfXYZ run[3];
+        for (int k = 0; k <= nbDeriv; ++k)
+        {
+            run[k] = {results[k].x + first, results[k].y + first, results[k].z + first};
+        }
+        Geom_BezierKernel::EvaluateBatch(poles, params + first, last - first, nbDeriv, run);
+        first = last;
+    }
+
+    if (!sorted)
+    {
+        for (int i = 0; i < nbParams; ++i)
+        {
+            for (int k = 0; k <= nbDeriv; ++k)
+            {
+                d[k].SetValue(order[i], results[k].Value(i));
+            }
+        }
+    }
+}
@@ -0,0 +1,154 @@
+// A set of Bezier curves of any degrees stored in flat arrays, without an object per curve:
+// - the poles of all the curves follow each other in one array, the poles of the curve i
+//   are at the indices Offset(i), ..., Offset(i + 1) - 1,
+// - the weights of the rational curves follow each other in a second array,
+//   a non-rational curve stores no weight.
+// The curves are read through views, evaluated in batches and bounded without touching the heap.
+
+#ifndef GEOM_BEZIERCURVESET_H
+#define GEOM_BEZIERCURVESET_H
+
+#include "geom_BezierCurveView.h"
+#include "geom_BSplineCurve.h"
+
+class Geom_BezierCurveSet
+{
+public:
+    // Forward iterator on the views of the curves.
+    class Iterator
+    {
+    public:
+        Iterator(const Geom_BezierCurveSet& set, const int index)
+            : m_set(&set),
+              m_index(index)
+        {
+        }
+
+        inline Geom_BezierCurveView operator*() const
+        {
+            return m_set->Curve(m_index);
+        }
+
+        inline Iterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        inline bool operator!=(const Iterator& other) const
+        {
+            return m_index != other.m_index;
+        }
+
+    private:
+        const Geom_BezierCurveSet* m_set;
+        int m_index;
+    };
+
+    // Creates an empty set.
+    Geom_BezierCurveSet();
+
+    // Reserves the storage of nbCurves curves of nbPoles poles in total.
+    void Reserve(const int nbCurves, const int nbPoles);
+
+    // Appends the curve of the nbPoles poles and weights, and returns its index.
+    // weights is null for a non-rational curve. If all the weights are identical the curve is considered as non rational.
+    // Raised if nbPoles is lower than 2 or greater than Geom_BezierCurve::MaxDegree() + 1,
+    // or if a weight is not greater than Resolution from package geometry.
+    int Append(const gp_Pnt* poles, const int nbPoles, const double* weights);
+
+    // Appends a copy of the curve and returns its index.
+    int Append(const Geom_BezierCurve& curve);
+
+    // Appends a copy of the curve and returns its index.
+    int Append(const Geom_BezierCurveView& curve);
+
+    // Appends the Bezier segments of the nbCurves B-spline curves, see Geom_BSplineCurve::BezierSegments().
+    // The storage of all the segments is reserved first, then the curves are decomposed in parallel
+    // directly into it, in chunks of curves holding a few thousand poles on average, see Parallel::For().
+    // The segments of a rational curve keep their weights. Returns the index of the first segment.
+    int AppendBezierSegments(const handle<Geom_BSplineCurve>* curves, const int nbCurves);
+
+    // Removes all the curves.
+    void Clear();
+
+    // Returns the number of curves.
+    inline int NbCurves() const
+    {
+        return static_cast<int>(m_offsets.size()) - 1;
+    }
+
+    // Returns the number of poles of all the curves.
+    inline int NbPoles() const
+    {
+        return static_cast<int>(m_poles.size());
+    }
+
+    // Returns the index of the first pole of the curve index, Offset(NbCurves()) is NbPoles().
+    inline int Offset(const int index) const
+    {
+        return m_offsets[index];
+    }
+
+    // Returns the degree of the curve index.
+    inline int Degree(const int index) const
+    {
+        return m_offsets[index + 1] - m_offsets[index] - 1;
+    }
+
+    // Returns true if the curve index has weights.
+    inline bool IsRational(const int index) const
+    {
+        return m_weightOffsets[index] >= 0;
+    }
+
+    // Returns the view of the curve index.
+    // Raised if index is not in the range [0, NbCurves() - 1].
+    Geom_BezierCurveView Curve(const int index) const;
+
+    // Returns the poles of all the curves.
+    inline const gp_Pnt* Poles() const
+    {
+        return m_poles.data();
+    }
+
+    inline Iterator begin() const
+    {
+        return Iterator(*this, 0);
+    }
+
+    inline Iterator end() const
+    {
+        return Iterator(*this, NbCurves());
+    }
+
+    // Computes the points of the curves curves[i] at the parameters params[i], i = 0, ..., nbParams - 1.
+    // The parameters of a curve are evaluated together by Geom_BezierKernel::EvaluateBatch(), in place if curves
+    // is sorted, otherwise in buffers holding the parameters and the results in the order of the curves.
+    // Raised if a curve index is not in the range [0, NbCurves() - 1].
+    void D0Batch(const int* curves, const double* params, const int nbParams, const gp_SoAOfXYZ& p) const;
+
+    // Computes the points and the first derivatives of the curves curves[i] at the parameters params[i].
+    void D1Batch(const int* curves, const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const;
+
+    // Computes the bounding boxes of the poles of all the curves, which contain the curves.
+    // The buffers of min and max must hold NbCurves() values.
+    void BoundingBoxes(const gp_SoAOfXYZ& min, const gp_SoAOfXYZ& max) const;
+
+private:
+    // Computes the points d[0] and the derivatives d[1], ..., d[nbDeriv] (nbDeriv <= 2) of the curves curves[i]
+    // at the parameters params[i].
+    void EvaluateBatch(const int* curves, const double* params, const int nbParams, const int nbDeriv, const gp_SoAOfXYZ* d) const;
+
+private:
+    std::vector<gp_Pnt> m_poles;
+    std::vector<double> m_weights;
+
+    // NbCurves() + 1 offsets in m_poles.
+    std::vector<int> m_offsets;
+
+    // Offsets in m_weights, -1 for a non-rational curve.
+    std::vector<int> m_weightOffsets;
+};
+
+#endif
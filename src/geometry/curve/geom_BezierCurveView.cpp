@@ -0,0 +1,104 @@
+#include "geom_BezierCurveView.h"
+
+gp_Pnt Geom_BezierCurveView::Value(const double u) const
+{
+    gp_Pnt p;
+    D0(u, p);
+    return p;
+}
+
+void Geom_BezierCurveView::D0(const double u, gp_Pnt& p) const
+{
+    Evaluate(u, 0, &p);
+}
+
+void Geom_BezierCurveView::D1(const double u, gp_Pnt& p, gp_Vec& v1) const
+{
+    gp_Vec d[2];
+    Evaluate(u, 1, d);
+    p = d[0];
+    v1 = d[1];
+}
+
+void Geom_BezierCurveView::D2(const double u, gp_Pnt& p, gp_Vec& v1, gp_Vec& v2) const
+{
+    gp_Vec d[3];
+    Evaluate(u, 2, d);
+    p = d[0];
+    v1 = d[1];
+    v2 = d[2];
+}
+
+void Geom_BezierCurveView::D0Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p) const
+{
+    Geom_BezierKernel::Poles poles;
+    TransposedPoles(poles);
+    Geom_BezierKernel::EvaluateBatch(poles, params, nbParams, 0, &p);
+}
+
+void Geom_BezierCurveView::D1Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const
+{
+    const gp_SoAOfXYZ d[2] = {p, v1};
+    Geom_BezierKernel::Poles poles;
+    TransposedPoles(poles);
+    Geom_BezierKernel::EvaluateBatch(poles, params, nbParams, 1, d);
+}
+
+void Geom_BezierCurveView::BoundingBox(gp_Pnt& min, gp_Pnt& max) const
+{
+    min = max = m_poles[0];
+    for (int i = 1; i <= m_degree; ++i)
+    {
+        min = glm::min(min, m_poles[i]);
+        max = glm::max(max, m_poles[i]);
+    }
+}
+
+void Geom_BezierCurveView::TransposedPoles(Geom_BezierKernel::Poles& poles) const
+{
+    poles.degree = m_degree;
+    poles.rational = IsRational();
+    for (int j = 0; j <= m_degree; ++j)
+    {
+        const double w = Weight(j);
+        poles.x[j] = w * m_poles[j].x;
+        poles.y[j] = w * m_poles[j].y;
+        poles.z[j] = w * m_poles[j].z;
+        poles.w[j] = w;
+    }
+}
+
+handle<Geom_BezierCurve> Geom_BezierCurveView::Curve() const
+{
+    const gp_Array1OfPnt poles(m_poles, m_poles + NbPoles());
+    if (IsRational())
+    {
+        const std_Array1OfReal weights(m_weights, m_weights + NbPoles());
+        return std::make_shared<Geom_BezierCurve>(poles, weights);
+    }
+    return std::make_shared<Geom_BezierCurve>(poles);
+}
+
+handle<Geom_BezierCurve> Geom_BezierCurveView::Curve(std::pmr::memory_resource* resource) const
+{
+    return Geom_BezierCurve::Make(resource, m_poles, NbPoles(), m_weights);
+}
+
+void Geom_BezierCurveView::Evaluate(const double u, const int nbDeriv, gp_Vec* d) const
+{
+    if (!IsRational())
+    {
+        Geom_BezierKernel::Casteljau(m_poles, m_degree, u, nbDeriv, d);
+        return;
+    }
+
+    gp_Pnt4d hpoles[Geom_BezierKernel::MaxNbPoles];
+    for (int j = 0; j <= m_degree; ++j)
+    {
+        hpoles[j] = gp_Pnt4d(m_weights[j] * m_poles[j], m_weights[j]);
+    }
+
+    gp_Pnt4d a[3];
+    Geom_BezierKernel::Casteljau(hpoles, m_degree, u, nbDeriv, a);
+    Geom_BezierKernel::RationalDerivatives(a, nbDeriv, d);
+}
@@ -0,0 +1,110 @@
+// A view describes a Bezier curve whose poles and weights are stored elsewhere, e.g. in a
+// Geom_BezierCurveSet. It holds two pointers and the degree: it is copied by value, never allocates
+// and is valid as long as the storage it reads.
+
+#ifndef GEOM_BEZIERCURVEVIEW_H
+#define GEOM_BEZIERCURVEVIEW_H
+
+#include "geom_BezierCurve.h"
+
+class Geom_BezierCurveView
+{
+public:
+    // Creates a view of the degree + 1 poles and weights.
+    // weights is null for a non-rational curve.
+    Geom_BezierCurveView(const gp_Pnt* poles, const double* weights, const int degree)
+        : m_poles(poles),
+          m_weights(weights),
+          m_degree(degree)
+    {
+    }
+
+    // Returns the polynomial degree of the curve.
+    inline int Degree() const
+    {
+        return m_degree;
+    }
+
+    // Returns the number of poles of this Bezier curve.
+    inline int NbPoles() const
+    {
+        return m_degree + 1;
+    }
+
+    // Returns true if the curve has weights.
+    inline bool IsRational() const
+    {
+        return m_weights != nullptr;
+    }
+
+    // Returns the pole of range index.
+    inline const gp_Pnt& Pole(const int index) const
+    {
+        return m_poles[index];
+    }
+
+    // Returns the weight of range index, 1 for a non-rational curve.
+    inline double Weight(const int index) const
+    {
+        return m_weights ? m_weights[index] : 1.0;
+    }
+
+    // Returns the poles, Degree() + 1 values.
+    inline const gp_Pnt* Poles() const
+    {
+        return m_poles;
+    }
+
+    // Returns the weights, null for a non-rational curve.
+    inline const double* Weights() const
+    {
+        return m_weights;
+    }
+
+    inline gp_Pnt StartPoint() const
+    {
+        return m_poles[0];
+    }
+
+    inline gp_Pnt EndPoint() const
+    {
+        return m_poles[m_degree];
+    }
+
+    // Computes the point of parameter u.
+    gp_Pnt Value(const double u) const;
+
+    void D0(const double u, gp_Pnt& p) const;
+
+    void D1(const double u, gp_Pnt& p, gp_Vec& v1) const;
+
+    void D2(const double u, gp_Pnt& p, gp_Vec& v1, gp_Vec& v2) const;
+
+    // Batch evaluations of blocks of parameters, see Geom_Curve::D0Batch.
+    void D0Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p) const;
+
+    void D1Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const;
+
+    // Computes the bounding box of the poles, which contains the curve.
+    void BoundingBox(gp_Pnt& min, gp_Pnt& max) const;
+
+    // Transposes the poles into rows of coordinates, homogeneous for a rational curve.
+    void TransposedPoles(Geom_BezierKernel::Poles& poles) const;
+
+    // Creates a curve owning a copy of the poles and weights.
+    handle<Geom_BezierCurve> Curve() const;
+
+    // Creates a curve owning a copy of the poles and weights, allocated from the resource, see Geom_BezierCurve::Make().
+    handle<Geom_BezierCurve> Curve(std::pmr::memory_resource* resource) const;
+
+private:
+    // Computes the point d[0] and the derivatives d[1], ..., d[nbDeriv] (nbDeriv <= 2) of the parameter u.
+    void Evaluate(const double u, const int nbDeriv, gp_Vec* d) const;
+
+private:
+    const gp_Pnt* m_poles;
+    const double* m_weights;
+    int m_degree;
+};
+
+#endif
@@ -0,0 +1,224 @@
+#include "geom_BezierEvaluator.h"
+#include "exceptions.h"
+
+#include <array>
+#include <utility>
+
+namespace
+{
+    template <typename F, int... K>
+    inline void UnrollImpl(F& f, std::integer_sequence<int, K...>)
+    {
+        (f(std::integral_constant<int, K>()), ...);
+    }
+
+    // Calls f(std::integral_constant<int, 0>()), ..., f(std::integral_constant<int, Count - 1>()) in sequence.
+    template <int Count, typename F>
+    inline void Unroll(F&& f)
+    {
+        UnrollImpl(f, std::make_integer_sequence<int, Count>());
+    }
+
+    // Sum of the Bernstein polynomials. The derivatives are the Bernstein sums of lower degree
+    // on the differences of the poles: P' = n Sum(B[n-1, i] DeltaP[i]), P'' = n (n-1) Sum(B[n-2, i] Delta2P[i]),
+    // P''' = n (n-1) (n-2) Sum(B[n-3, i] Delta3P[i]).
+    template <int Degree, int Dim, int NbDeriv>
+    void Bernstein(const Geom_BezierEvaluator::Input& input, const double u, gp_Pnt4d* a)
+    {
+        double p[Degree + 1][Dim];
+        for (int i = 0; i <= Degree; ++i)
+        {
+            for (int c = 0; c < Dim; ++c)
+            {
+                if constexpr (Dim == 4)
+                {
+                    p[i][c] = input.hpoles[i][c];
+                }
+                else
+                {
+                    p[i][c] = input.poles[i][c];
+                }
+            }
+        }
+
+        // Powers of u and (1 - u).
+        const double s = 1.0 - u;
+        double tp[Degree + 1], sp[Degree + 1];
+        tp[0] = sp[0] = 1.0;
+        Unroll<Degree>([&](auto i)
+        {
+            constexpr int k = decltype(i)::value + 1;
+            tp[k] = tp[k - 1] * u;
+            sp[k] = sp[k - 1] * s;
+        });
+
+        double d0[Dim] = {}, d1[Dim] = {}, d2[Dim] = {}, d3[Dim] = {};
+        Unroll<Degree + 1>([&](auto i)
+        {
+            constexpr int k = decltype(i)::value;
+            const double b0 = Geom_BezierKernel::Binomial(Degree, k) * tp[k] * sp[Degree - k];
+            for (int c = 0; c < Dim; ++c)
+            {
+                d0[c] += b0 * p[k][c];
+            }
+            if constexpr (NbDeriv >= 1 && k < Degree)
+            {
+                const double b1 = Geom_BezierKernel::Binomial(Degree - 1, k) * tp[k] * sp[Degree - 1 - k];
+                for (int c = 0; c < Dim; ++c)
+                {
+                    d1[c] += b1 * (p[k + 1][c] - p[k][c]);
+                }
+            }
+            if constexpr (NbDeriv >= 2 && k + 1 < Degree)
+            {
+                const double b2 = Geom_BezierKernel::Binomial(Degree - 2, k) * tp[k] * sp[Degree - 2 - k];
+                for (int c = 0; c < Dim; ++c)
+                {
+                    d2[c] += b2 * (p[k + 2][c] - 2.0 * p[k + 1][c] + p[k][c]);
+                }
+            }
+            if constexpr (NbDeriv >= 3 && k + 2 < Degree)
+            {
+                const double b3 = Geom_BezierKernel::Binomial(Degree - 3, k) * tp[k] * sp[Degree - 3 - k];
+                for (int c = 0; c < Dim; ++c)
+                {
+                    d3[c] += b3 * (p[k + 3][c] - 3.0 * (p[k + 2][c] - p[k + 1][c]) - p[k][c]);
+                }
+            }
+        });
+
+        for (int c = 0; c < Dim; ++c)
+        {
+            a[0][c] = d0[c];
+            if constexpr (NbDeriv >= 1)
+            {
+                a[1][c] = Degree * d1[c];
+            }
+            if constexpr (NbDeriv >= 2)
+            {
+                a[2][c] = Degree * (Degree - 1) * d2[c];
+            }
+            if constexpr (NbDeriv >= 3)
+            {
+                a[3][c] = Degree * (Degree - 1) * (Degree - 2) * d3[c];
+            }
+        }
+    }
+
+    // Forward differencing: the differences of the point, and of its first derivative, are kept in registers
+    // and each parameter costs Degree additions per coordinate.
+    template <int Degree, bool Rational, int NbDeriv>
+    void Step(const gp_Pnt4d* point, const gp_Pnt4d* derivative, const int first, const int nbPoints, const gp_SoAOfXYZ* d)
+    {
+        constexpr int Dim = Rational ? 4 : 3;
+        double p[Degree + 1][Dim] = {}, v[Degree][Dim] = {};
+        for (int c = 0; c < Dim; ++c)
+        {
+            for (int k = 0; k <= Degree; ++k)
+            {
+                p[k][c] = point[k][c];
+            }
+            if constexpr (NbDeriv >= 1)
+            {
+                for (int k = 0; k < Degree; ++k)
+                {
+                    v[k][c] = derivative[k][c];
+                }
+            }
+        }
+
+        for (int i = first; i < first + nbPoints; ++i)
+        {
+            if (i != first)
+            {
+                Unroll<Degree>([&](auto kk)
+                {
+                    constexpr int k = decltype(kk)::value;
+                    for (int c = 0; c < Dim; ++c)
+                    {
+                        p[k][c] += p[k + 1][c];
+                    }
+                });
+                if constexpr (NbDeriv >= 1)
+                {
+                    Unroll<Degree - 1>([&](auto kk)
+                    {
+                        constexpr int k = decltype(kk)::value;
+                        for (int c = 0; c < Dim; ++c)
+                        {
+                            v[k][c] += v[k + 1][c];
+                        }
+                    });
+                }
+            }
+
+            gp_Vec pnt(p[0][0], p[0][1], p[0][2]);
+            double invW = 1.0;
+            if constexpr (Rational)
+            {
+                invW = 1.0 / p[0][3];
+                pnt *= invW;
+            }
+            d[0].SetValue(i, pnt);
+
+            if constexpr (NbDeriv >= 1)
+            {
+                // C' = (A' - w' C) / w for a rational curve.
+                gp_Vec vec(v[0][0], v[0][1], v[0][2]);
+                if constexpr (Rational)
+                {
+                    vec = (vec - v[0][3] * pnt) * invW;
+                }
+                d[1].SetValue(i, vec);
+            }
+        }
+    }
+
+    // Row of the jump table: the orders of derivation for non-rational then rational curves.
+    // The steppers follow, by rationality then order of derivation.
+    struct Row
+    {
+        Geom_BezierEvaluator::Function functions[2][Geom_BezierEvaluator::MaxNbDeriv + 1];
+        Geom_BezierEvaluator::Stepper steppers[2][2];
+    };
+
+    template <int Degree, int... NbDeriv>
+    constexpr Row MakeRow(std::integer_sequence<int, NbDeriv...>)
+    {
+        return {{{&Bernstein<Degree, 3, NbDeriv>...},
+                 {&Bernstein<Degree, 4, NbDeriv>...}},
+                {{&Step<Degree, false, 0>, &Step<Degree, false, 1>},
+                 {&Step<Degree, true, 0>, &Step<Degree, true, 1>}}};
+    }
+
+    template <int Degree>
+    constexpr Row MakeRow()
+    {
+        return MakeRow<Degree>(std::make_integer_sequence<int, Geom_BezierEvaluator::MaxNbDeriv + 1>());
+    }
+
+    // The degree 0 row is never selected, it only keeps the table indexed by degree.
+    template <int... Degree>
+    constexpr std::array<Row, sizeof...(Degree) + 1> MakeTable(std::integer_sequence<int, Degree...>)
+    {
+        return {{Row{}, MakeRow<Degree + 1>()...}};
+    }
+
+    constexpr std::array<Row, Geom_BezierKernel::MaxNbPoles> Table =
+        MakeTable(std::make_integer_sequence<int, Geom_BezierKernel::MaxNbPoles - 1>());
+}
+
+const Geom_BezierEvaluator::Function* Geom_BezierEvaluator::Select(const int degree, const bool rational)
+{
+    VALIDATE_ARGUMENT_RANGE(degree, 1, Geom_BezierKernel::MaxNbPoles - 1);
+
+    return Table[degree].functions[rational ? 1 : 0];
+}
+
+Geom_BezierEvaluator::Stepper Geom_BezierEvaluator::SelectStepper(const int degree, const bool rational, const int nbDeriv)
+{
+    VALIDATE_ARGUMENT_RANGE(degree, 1, Geom_BezierKernel::MaxNbPoles - 1);
+    VALIDATE_ARGUMENT_RANGE(nbDeriv, 0, 1);
+
+    return Table[degree].steppers[rational ? 1 : 0][nbDeriv];
+}
@@ -0,0 +1,51 @@
+// Evaluators of a single point of a Bezier curve, specialized on the degree, the rationality
+// and the order of derivation so that the loops on the coefficients are fully unrolled.
+// They sum the Bernstein polynomials weighted by binomial coefficients computed at compile time, straight
+// from the poles: a curve evaluated a few times does not pay for a conversion to the power basis.
+// A curve selects the row of the jump table matching its degree and rationality once, when they change.
+// The same table holds the steppers of the forward differencing along uniform parameters.
+
+#ifndef GEOM_BEZIEREVALUATOR_H
+#define GEOM_BEZIEREVALUATOR_H
+
+#include "geom_BezierKernel.h"
+
+class Geom_BezierEvaluator
+{
+public:
+    // Coefficients read by an evaluator. Only the member matching the rationality is read:
+    // - poles for a non-rational curve,
+    // - hpoles, the homogeneous poles (w*x, w*y, w*z, w), for a rational curve.
+    struct Input
+    {
+        const gp_Pnt* poles;
+        const gp_Pnt4d* hpoles;
+    };
+
+    // Computes the homogeneous point a[0] and derivatives a[1], ..., a[nbDeriv] of the parameter u,
+    // where nbDeriv is the index of the function in its row. The w coordinate is not set for a non-rational curve.
+    using Function = void (*)(const Input& input, const double u, gp_Pnt4d* a);
+
+    // Highest order of derivation with specialized evaluators, enough for the derivative of the curvature.
+    static constexpr int MaxNbDeriv = 3;
+
+    // Returns the row of MaxNbDeriv + 1 evaluators, of orders 0 to MaxNbDeriv, specialized for the degree and the rationality.
+    static const Function* Select(const int degree, const bool rational);
+
+    // Steps the forward differences of a homogeneous point, point[k] of order k, and of its first derivative
+    // over nbPoints parameters. Stores the points into d[0] and, for a stepper of order 1, the first derivatives
+    // into d[1], at the indices first, ..., first + nbPoints - 1.
+    // The w coordinates are not read for a non-rational curve.
+    using Stepper = void (*)(const gp_Pnt4d* point, const gp_Pnt4d* derivative, const int first, const int nbPoints, const gp_SoAOfXYZ* d);
+
+    // Returns the stepper specialized for the degree, the rationality and the order of derivation (0 or 1).
+    static Stepper SelectStepper(const int degree, const bool rational, const int nbDeriv);
+
+    // Returns true if the batch evaluation of this degree runs the Horner scheme on the power basis.
+    static constexpr bool UsesMonomials(const int degree)
+    {
+        return degree <= Geom_BezierKernel::MaxMonomialDegree;
+    }
+};
+
+#endif
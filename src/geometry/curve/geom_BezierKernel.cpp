@@ -0,0 +1,181 @@
+#include "geom_BezierKernel.h"
+#include "geom_BezierKernelImpl.h"
+#include "exceptions.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    // One lane, used when no vector instruction set is available.
+    struct ScalarV
+    {
+        using Mask = bool;
+        static constexpr int Width = 1;
+        double v;
+
+        static ScalarV Load(const double* p) { return {*p}; }
+        static ScalarV Set1(const double a) { return {a}; }
+        static Mask Greater(const ScalarV a, const ScalarV b) { return a.v > b.v; }
+        static ScalarV Select(const Mask m, const ScalarV a, const ScalarV b) { return m ? b : a; }
+        void Store(double* p) const { *p = v; }
+
+        friend ScalarV operator+(const ScalarV a, const ScalarV b) { return {a.v + b.v}; }
+        friend ScalarV operator-(const ScalarV a, const ScalarV b) { return {a.v - b.v}; }
+        friend ScalarV operator*(const ScalarV a, const ScalarV b) { return {a.v * b.v}; }
+        friend ScalarV operator/(const ScalarV a, const ScalarV b) { return {a.v / b.v}; }
+    };
+
+    // Copies the buffers of the results d[0], ..., d[nbDeriv] for the kernels.
+    void ToRows(const gp_SoAOfXYZ* d, const int nbDeriv, Geom_BezierKernelData::Rows* rows)
+    {
+        for (int k = 0; k <= nbDeriv; ++k)
+        {
+            rows[k] = {d[k].x, d[k].y, d[k].z};
+        }
+    }
+
+    // Implementation selected for the batch evaluation, chosen on first use.
+    std::atomic<int>& SelectedSet()
+    {
+        static std::atomic<int> selected(-1);
+        return selected;
+    }
+}
+
+const Geom_BezierKernelData::Implementation* Geom_BezierKernelData::Scalar()
+{
+    static const Implementation implementation = {&EvaluateBatchImpl<ScalarV>, &EvaluateMonomialBatchImpl<ScalarV>, &EvaluatePackImpl<ScalarV>};
+    return &implementation;
+}
+
+const Geom_BezierKernel::Implementation* Geom_BezierKernel::Kernels(const CPU_InstructionSet set)
+{
+    switch (set)
+    {
+    case CPU_InstructionSet::CPU_AVX512:
+        return Geom_BezierKernelData::AVX512();
+    case CPU_InstructionSet::CPU_AVX2:
+        return Geom_BezierKernelData::AVX2();
+    case CPU_InstructionSet::CPU_SSE2:
+        return Geom_BezierKernelData::SSE2();
+    default:
+        return Geom_BezierKernelData::Scalar();
+    }
+}
+
+void Geom_BezierKernel::ToMonomials(const Poles& poles, Monomials& monomials)
+{
+    const int degree = poles.degree;
+    monomials.degree = degree;
+    monomials.rational = poles.rational;
+
+    const double* rows[4] = {poles.x, poles.y, poles.z, poles.w};
+    double (*coefficients[4])[MaxNbPoles] = {monomials.x, monomials.y, monomials.z, monomials.w};
+    for (int c = 0; c < (poles.rational ? 4 : 3); ++c)
+    {
+        // The coefficient k is Binomial(degree, k) times the k-th forward difference
+        // of the poles at the start for u = 0, at the end for u = 1.
+        double delta[MaxNbPoles];
+        std::copy(rows[c], rows[c] + degree + 1, delta);
+
+        for (int k = 0; k <= degree; ++k)
+        {
+            coefficients[c][0][k] = Binomial(degree, k) * delta[0];
+            coefficients[c][1][k] = Binomial(degree, k) * delta[degree - k];
+
+            for (int i = 0; i < degree - k; ++i)
+            {
+                delta[i] = delta[i + 1] - delta[i];
+            }
+        }
+    }
+}
+
+void Geom_BezierKernel::EvaluateBatch(const Poles& poles, const double* params, const int nbParams, const int nbDeriv, const gp_SoAOfXYZ* d)
+{
+    VALIDATE_ARGUMENT_RANGE(nbDeriv, 0, 2);
+
+    Geom_BezierKernelData::Rows rows[3];
+    ToRows(d, nbDeriv, rows);
+    Kernels(InstructionSet())->bernstein(poles, params, nbParams, nbDeriv, rows);
+}
+
+void Geom_BezierKernel::EvaluateBatch(const Monomials& monomials, const double* params, const int nbParams, const int nbDeriv, const gp_SoAOfXYZ* d)
+{
+    VALIDATE_ARGUMENT_RANGE(nbDeriv, 0, 2);
+
+    Geom_BezierKernelData::Rows rows[3];
+    ToRows(d, nbDeriv, rows);
+    Kernels(InstructionSet())->monomial(monomials, params, nbParams, nbDeriv, rows);
+}
+
+void Geom_BezierKernel::EvaluatePack(const double* poles, const int degree, const bool rational, const double u,
+                                     const int nbDeriv, const gp_SoAOfXYZ* d, const int first)
+{
+    VALIDATE_ARGUMENT_RANGE(nbDeriv, 0, 2);
+
+    Geom_BezierKernelData::Rows rows[3];
+    ToRows(d, nbDeriv, rows);
+    Kernels(InstructionSet())->pack(poles, degree, rational, u, nbDeriv, rows, first);
+}
+
+CPU_InstructionSet Geom_BezierKernel::InstructionSet()
+{
+    int selected = SelectedSet().load(std::memory_order_relaxed);
+    if (selected < 0)
+    {
+        SetInstructionSet(CPU::Best());
+        selected = SelectedSet().load(std::memory_order_relaxed);
+    }
+    return static_cast<CPU_InstructionSet>(selected);
+}
+
+void Geom_BezierKernel::SetInstructionSet(const CPU_InstructionSet set)
+{
+    // Lower the request until an implementation is both compiled and supported.
+    int candidate = static_cast<int>(set);
+    while (candidate > 0)
+    {
+        const CPU_InstructionSet s = static_cast<CPU_InstructionSet>(candidate);
+        if (CPU::Supports(s) && Kernels(s) != nullptr)
+        {
+            break;
+        }
+        --candidate;
+    }
+    SelectedSet().store(candidate, std::memory_order_relaxed);
+}
+
+void Geom_BezierKernel::Bernstein(const int degree, const double u, double* b)
+{
+    const double v = 1.0 - u;
+    b[0] = 1.0;
+    for (int k = 1; k <= degree; ++k)
+    {
+        double previous = 0.0;
+        for (int j = 0; j < k; ++j)
+        {
+            const double value = b[j];
+            b[j] = v * value + previous;
+            previous = u * value;
+        }
+        b[k] = previous;
+    }
+}
+
+void Geom_BezierKernel::RationalDerivatives(const gp_Pnt4d* a, const int nbDeriv, gp_Vec* d)
+{
+    const double invW = 1.0 / a[0].w;
+    for (int k = 0; k <= nbDeriv; ++k)
+    {
+        gp_Vec v(a[k]);
+        double binomial = 1.0;
+        for (int i = 1; i <= k; ++i)
+        {
+            binomial = (k < MaxNbPoles) ? Binomial(k, i) : binomial * (k - i + 1) / i;
+            v -= binomial * a[i].w * d[k - i];
+        }
+        d[k] = v * invW;
+    }
+}
@@ -0,0 +1,163 @@
+// Evaluation kernels of Bezier curves on blocks of parameters.
+// The coefficients are transposed into rows of coordinates and each instruction evaluates
+// 8 (AVX-512), 4 (AVX2), 2 (SSE2) or 1 parameters of the block, either with the de Casteljau
+// algorithm on the poles or with the Horner scheme on the power basis coefficients.
+// The widest instruction set supported by the running CPU is selected on first use.
+
+#ifndef GEOM_BEZIERKERNEL_H
+#define GEOM_BEZIERKERNEL_H
+
+#include "geom_BezierKernelData.h"
+#include "geometry.h"
+#include "cpu.h"
+
+#include <algorithm>
+
+class Geom_BezierKernel
+{
+public:
+    // Maximum number of poles of a Bezier curve, that is Geom_BezierCurve::MaxDegree() + 1.
+    static constexpr int MaxNbPoles = Geom_BezierKernelData::MaxNbPoles;
+
+    // Poles of a Bezier curve transposed into rows of coordinates.
+    using Poles = Geom_BezierKernelData::Poles;
+
+    // Highest degree evaluated in the power basis.
+    // The conversion amplifies the rounding errors by up to 2^degree relative to the size of the poles,
+    // about 1.e-12 at this degree. Higher degrees keep the de Casteljau algorithm which is stable.
+    static constexpr int MaxMonomialDegree = 12;
+
+    // Power basis coefficients of a Bezier curve, expanded at both ends of the parameter range.
+    using Monomials = Geom_BezierKernelData::Monomials;
+
+    // Converts the poles to the power basis.
+    static void ToMonomials(const Poles& poles, Monomials& monomials);
+
+    // Computes the points d[0] and the derivatives d[1], ..., d[nbDeriv] (nbDeriv <= 2)
+    // of the nbParams parameters params.
+    // Raised if nbDeriv is not in the range [0, 2].
+    static void EvaluateBatch(const Poles& poles, const double* params, const int nbParams, const int nbDeriv, const gp_SoAOfXYZ* d);
+
+    // Same as above from the power basis coefficients.
+    static void EvaluateBatch(const Monomials& monomials, const double* params, const int nbParams, const int nbDeriv, const gp_SoAOfXYZ* d);
+
+    // Returns the instruction set used by the batch evaluation.
+    static CPU_InstructionSet InstructionSet();
+
+    // Forces the instruction set used by the batch evaluation, e.g. to compare the implementations.
+    // The request is lowered to the widest instruction set supported by the CPU and compiled in the library.
+    static void SetInstructionSet(const CPU_InstructionSet set);
+
+    // Returns the binomial coefficient C(n, k) for 0 <= k <= n < MaxNbPoles, read from a table computed at compile time.
+    static constexpr double Binomial(const int n, const int k);
+
+    // Computes with the de Casteljau algorithm the point d[0] and the derivatives
+    // d[1], ..., d[nbDeriv] (nbDeriv <= 2) of the Bezier curve of the given poles.
+    // The derivatives are read from the last levels of the triangle.
+    template <typename Vec>
+    static void Casteljau(const Vec* poles, const int degree, const double u, const int nbDeriv, Vec* d);
+
+    // Elevates in place the poles of a Bezier curve from the degree n to the degree m in one pass:
+    // Q[i] = Sum(j) Binomial(n, j) * Binomial(m - n, i - j) / Binomial(m, i) * P[j].
+    // The buffer poles must hold m + 1 values.
+    template <typename Pnt>
+    static void Elevate(Pnt* poles, const int n, const int m);
+
+    // Number of curves interleaved in a pack, the lanes of the widest instruction set.
+    static constexpr int PackWidth = Geom_BezierKernelData::PackWidth;
+
+    // Computes the points d[0] and the derivatives d[1], ..., d[nbDeriv] (nbDeriv <= 2) at the parameter u
+    // of the PackWidth curves of a pack, and stores them at the indices first, ..., first + PackWidth - 1.
+    // The coordinate c of the pole j of the curve l is poles[(j * dim + c) * PackWidth + l], where dim is 4
+    // for a rational pack with homogeneous coordinates (w*x, w*y, w*z, w), 3 otherwise.
+    // Raised if nbDeriv is not in the range [0, 2].
+    static void EvaluatePack(const double* poles, const int degree, const bool rational, const double u,
+                             const int nbDeriv, const gp_SoAOfXYZ* d, const int first);
+
+    // Computes the Bernstein polynomials b[0], ..., b[degree] at the parameter u with the triangular scheme,
+    // which only sums positive terms.
+    static void Bernstein(const int degree, const double u, double* b);
+
+    // Computes the derivatives d[0], ..., d[nbDeriv] of a rational curve from the derivatives a[0], ..., a[nbDeriv]
+    // of its homogeneous curve with the Leibniz rule: C(k) = (A(k) - Sum(i = 1..k) Binomial(k, i) * w(i) * C(k - i)) / w.
+    static void RationalDerivatives(const gp_Pnt4d* a, const int nbDeriv, gp_Vec* d);
+
+private:
+    using Implementation = Geom_BezierKernelData::Implementation;
+
+    static const Implementation* Kernels(const CPU_InstructionSet set);
+};
+
+// Pascal triangle up to the maximum degree, computed at compile time.
+struct Geom_BinomialTable
+{
+    double c[Geom_BezierKernel::MaxNbPoles][Geom_BezierKernel::MaxNbPoles];
+
+    constexpr Geom_BinomialTable() : c()
+    {
+        for (int n = 0; n < Geom_BezierKernel::MaxNbPoles; ++n)
+        {
+            c[n][0] = 1.0;
+            for (int k = 1; k <= n; ++k)
+            {
+                c[n][k] = c[n - 1][k - 1] + ((k < n) ? c[n - 1][k] : 0.0);
+            }
+        }
+    }
+};
+
+inline constexpr Geom_BinomialTable Geom_Binomials;
+
+constexpr double Geom_BezierKernel::Binomial(const int n, const int k)
+{
+    return Geom_Binomials.c[n][k];
+}
+
+template <typename Pnt>
+void Geom_BezierKernel::Elevate(Pnt* poles, const int n, const int m)
+{
+    // Q[i] only reads the poles P[j], j <= i, so the poles are overwritten from the last one.
+    const int k = m - n;
+    for (int i = m; i >= 0; --i)
+    {
+        const int last = std::min(n, i);
+        Pnt q = (Binomial(n, last) * Binomial(k, i - last)) * poles[last];
+        for (int j = last - 1; j >= std::max(0, i - k); --j)
+        {
+            q += (Binomial(n, j) * Binomial(k, i - j)) * poles[j];
+        }
+        poles[i] = q / Binomial(m, i);
+    }
+}
+
+template <typename Vec>
+void Geom_BezierKernel::Casteljau(const Vec* poles, const int degree, const double u, const int nbDeriv, Vec* d)
+{
+    Vec q[MaxNbPoles];
+    std::copy(poles, poles + degree + 1, q);
+
+    const double s = 1.0 - u;
+    for (int r = degree; r > 0; --r)
+    {
+        if (r == 2 && nbDeriv >= 2)
+        {
+            d[2] = double(degree * (degree - 1)) * (q[2] - 2.0 * q[1] + q[0]);
+        }
+        if (r == 1 && nbDeriv >= 1)
+        {
+            d[1] = double(degree) * (q[1] - q[0]);
+        }
+        for (int j = 0; j < r; ++j)
+        {
+            q[j] = s * q[j] + u * q[j + 1];
+        }
+    }
+    d[0] = q[0];
+
+    if (nbDeriv >= 2 && degree < 2)
+    {
+        d[2] = Vec(0.0);
+    }
+}
+
+#endif
@@ -0,0 +1,66 @@
+// Plain data exchanged between Geom_BezierKernel and the kernels compiled for each instruction set.
+// The translation units compiled with a wide instruction set include this header only: it has
+// no inline function, so that none of their code can be shared with the rest of the library.
+
+#ifndef GEOM_BEZIERKERNELDATA_H
+#define GEOM_BEZIERKERNELDATA_H
+
+struct Geom_BezierKernelData
+{
+    // Maximum number of poles of a Bezier curve, that is Geom_BezierCurve::MaxDegree() + 1.
+    static constexpr int MaxNbPoles = 26;
+
+    // Number of curves interleaved in a pack, the lanes of the widest instruction set.
+    static constexpr int PackWidth = 8;
+
+    // Poles of a Bezier curve transposed into rows of coordinates.
+    // The rows of a rational curve hold the homogeneous coordinates (w*x, w*y, w*z, w),
+    // the row w is not read for a non-rational curve.
+    struct Poles
+    {
+        int degree;
+        bool rational;
+        double x[MaxNbPoles];
+        double y[MaxNbPoles];
+        double z[MaxNbPoles];
+        double w[MaxNbPoles];
+    };
+
+    // Power basis coefficients of a Bezier curve, in homogeneous coordinates for a rational curve.
+    // Row [0] is the expansion in u at u = 0 and row [1] the expansion in (u - 1) at u = 1,
+    // parameters greater than 0.5 read the second one so that the Horner scheme runs on |x| <= 0.5.
+    struct Monomials
+    {
+        int degree;
+        bool rational;
+        double x[2][MaxNbPoles];
+        double y[2][MaxNbPoles];
+        double z[2][MaxNbPoles];
+        double w[2][MaxNbPoles];
+    };
+
+    // Buffers of x, y and z coordinates written by the kernels, the fields of gp_SoAOfXYZ.
+    struct Rows
+    {
+        double* x;
+        double* y;
+        double* z;
+    };
+
+    // Kernels compiled for an instruction set.
+    struct Implementation
+    {
+        void (*bernstein)(const Poles&, const double*, int, int, const Rows*);
+        void (*monomial)(const Monomials&, const double*, int, int, const Rows*);
+        void (*pack)(const double*, int, bool, double, int, const Rows*, int);
+    };
+
+    // Returns the kernels of an instruction set, or nullptr if they have not been compiled.
+    // Neither these functions nor the kernels of an instruction set may be called if the CPU does not support it.
+    static const Implementation* Scalar();
+    static const Implementation* SSE2();
+    static const Implementation* AVX2();
+    static const Implementation* AVX512();
+};
+
+#endif
@@ -0,0 +1,272 @@
+// Implementation of the batch kernels of Geom_BezierKernel, written once for a generic
+// vector of parameters V and included by the translation unit of each instruction set.
+// Everything is in an anonymous namespace and only plain data is included, so that code compiled
+// for a wide instruction set is never shared with the translation units compiled for narrower ones.
+//
+// V must provide:
+// - Width, the number of lanes,
+// - Load and Store on unaligned memory, Set1,
+// - the operators +, -, * and /,
+// - a type Mask, Greater(a, b) and Select(mask, a, b) returning b in the lanes where mask is set.
+
+#ifndef GEOM_BEZIERKERNELIMPL_H
+#define GEOM_BEZIERKERNELIMPL_H
+
+#include "geom_BezierKernelData.h"
+
+namespace
+{
+    // Loads the block of parameters starting at first, the last block is padded with zeros.
+    // Returns the number of valid lanes.
+    template <typename V>
+    int LoadBlock(const double* params, const int nbParams, const int first, double* buffer, V& t)
+    {
+        const int count = (nbParams - first < V::Width) ? (nbParams - first) : V::Width;
+        if (count < V::Width)
+        {
+            for (int l = 0; l < V::Width; ++l)
+            {
+                buffer[l] = (l < count) ? params[first + l] : 0.0;
+            }
+            t = V::Load(buffer);
+        }
+        else
+        {
+            t = V::Load(params + first);
+        }
+        return count;
+    }
+
+    // Replaces the homogeneous derivatives r[k][0..3] by the derivatives of the rational curve,
+    // with a single division by w.
+    template <typename V>
+    void Quotient(const int nbDeriv, V (*r)[4])
+    {
+        const V two = V::Set1(2.0);
+        const V invW = V::Set1(1.0) / r[0][3];
+        for (int c = 0; c < 3; ++c)
+        {
+            r[0][c] = r[0][c] * invW;
+            if (nbDeriv >= 1)
+            {
+                r[1][c] = (r[1][c] - r[1][3] * r[0][c]) * invW;
+            }
+            if (nbDeriv >= 2)
+            {
+                r[2][c] = (r[2][c] - two * r[1][3] * r[1][c] - r[2][3] * r[0][c]) * invW;
+            }
+        }
+    }
+
+    // Stores the count valid lanes of r[0..nbDeriv] in the results at first.
+    template <typename V>
+    void StoreBlock(V (*r)[4], const int nbDeriv, const Geom_BezierKernelData::Rows* d, const int first, const int count, double* buffer)
+    {
+        for (int k = 0; k <= nbDeriv; ++k)
+        {
+            double* results[3] = {d[k].x + first, d[k].y + first, d[k].z + first};
+            for (int c = 0; c < 3; ++c)
+            {
+                if (count == V::Width)
+                {
+                    r[k][c].Store(results[c]);
+                    continue;
+                }
+
+                r[k][c].Store(buffer);
+                for (int l = 0; l < count; ++l)
+                {
+                    results[c][l] = buffer[l];
+                }
+            }
+        }
+    }
+
+    // de Casteljau algorithm on the poles, the derivatives are read from the last levels of the triangle.
+    template <typename V>
+    void EvaluateBatchImpl(const Geom_BezierKernelData::Poles& poles, const double* params, const int nbParams,
+                           const int nbDeriv, const Geom_BezierKernelData::Rows* d)
+    {
+        const int degree = poles.degree;
+        const int dim = poles.rational ? 4 : 3;
+        const double* rows[4] = {poles.x, poles.y, poles.z, poles.w};
+
+        const V one = V::Set1(1.0);
+        const V two = V::Set1(2.0);
+        const V factor1 = V::Set1(degree);
+        const V factor2 = V::Set1(degree * (degree - 1));
+        const V zero = V::Set1(0.0);
+
+        alignas(64) double buffer[V::Width];
+        V q[4][Geom_BezierKernelData::MaxNbPoles];
+        V r[3][4];
+
+        for (int first = 0; first < nbParams; first += V::Width)
+        {
+            V t;
+            const int count = LoadBlock(params, nbParams, first, buffer, t);
+            const V s = one - t;
+
+            for (int c = 0; c < dim; ++c)
+            {
+                for (int j = 0; j <= degree; ++j)
+                {
+                    q[c][j] = V::Set1(rows[c][j]);
+                }
+            }
+
+            for (int level = degree; level > 0; --level)
+            {
+                for (int c = 0; c < dim; ++c)
+                {
+                    if (level == 2 && nbDeriv >= 2)
+                    {
+                        r[2][c] = factor2 * (q[c][2] - two * q[c][1] + q[c][0]);
+                    }
+                    if (level == 1 && nbDeriv >= 1)
+                    {
+                        r[1][c] = factor1 * (q[c][1] - q[c][0]);
+                    }
+                    for (int j = 0; j < level; ++j)
+                    {
+                        q[c][j] = s * q[c][j] + t * q[c][j + 1];
+                    }
+                }
+            }
+
+            for (int c = 0; c < dim; ++c)
+            {
+                r[0][c] = q[c][0];
+                if (nbDeriv >= 2 && degree < 2)
+                {
+                    r[2][c] = zero;
+                }
+            }
+
+            if (poles.rational)
+            {
+                Quotient(nbDeriv, r);
+            }
+            StoreBlock(r, nbDeriv, d, first, count, buffer);
+        }
+    }
+
+    // de Casteljau algorithm on a pack of curves interleaved by lane, at a single parameter.
+    // Each instruction evaluates V::Width curves of the pack.
+    template <typename V>
+    void EvaluatePackImpl(const double* poles, const int degree, const bool rational, const double u,
+                          const int nbDeriv, const Geom_BezierKernelData::Rows* d, const int first)
+    {
+        constexpr int Width = Geom_BezierKernelData::PackWidth;
+        static_assert(Width % V::Width == 0, "The pack must hold whole vectors");
+
+        const int dim = rational ? 4 : 3;
+        const V t = V::Set1(u);
+        const V s = V::Set1(1.0 - u);
+        const V two = V::Set1(2.0);
+        const V factor1 = V::Set1(degree);
+        const V factor2 = V::Set1(degree * (degree - 1));
+        const V zero = V::Set1(0.0);
+
+        alignas(64) double buffer[V::Width];
+        V q[Geom_BezierKernelData::MaxNbPoles];
+        V r[3][4];
+
+        for (int lane = 0; lane < Width; lane += V::Width)
+        {
+            for (int c = 0; c < dim; ++c)
+            {
+                for (int j = 0; j <= degree; ++j)
+                {
+                    q[j] = V::Load(poles + (j * dim + c) * Width + lane);
+                }
+
+                for (int level = degree; level > 0; --level)
+                {
+                    if (level == 2 && nbDeriv >= 2)
+                    {
+                        r[2][c] = factor2 * (q[2] - two * q[1] + q[0]);
+                    }
+                    if (level == 1 && nbDeriv >= 1)
+                    {
+                        r[1][c] = factor1 * (q[1] - q[0]);
+                    }
+                    for (int j = 0; j < level; ++j)
+                    {
+                        q[j] = s * q[j] + t * q[j + 1];
+                    }
+                }
+
+                r[0][c] = q[0];
+                if (nbDeriv >= 2 && degree < 2)
+                {
+                    r[2][c] = zero;
+                }
+            }
+
+            if (rational)
+            {
+                Quotient(nbDeriv, r);
+            }
+            StoreBlock(r, nbDeriv, d, first + lane, V::Width, buffer);
+        }
+    }
+
+    // Horner scheme on the power basis, each lane reads the expansion of its half of the parameter range.
+    template <typename V>
+    void EvaluateMonomialBatchImpl(const Geom_BezierKernelData::Monomials& monomials, const double* params, const int nbParams,
+                                   const int nbDeriv, const Geom_BezierKernelData::Rows* d)
+    {
+        const int degree = monomials.degree;
+        const int dim = monomials.rational ? 4 : 3;
+        const double (*rows[4])[Geom_BezierKernelData::MaxNbPoles] = {monomials.x, monomials.y, monomials.z, monomials.w};
+
+        const V one = V::Set1(1.0);
+        const V two = V::Set1(2.0);
+        const V half = V::Set1(0.5);
+        const V zero = V::Set1(0.0);
+
+        alignas(64) double buffer[V::Width];
+        V r[3][4];
+
+        for (int first = 0; first < nbParams; first += V::Width)
+        {
+            V t;
+            const int count = LoadBlock(params, nbParams, first, buffer, t);
+            const typename V::Mask upper = V::Greater(t, half);
+            const V x = V::Select(upper, t, t - one);
+
+            for (int c = 0; c < dim; ++c)
+            {
+                const double* c0 = rows[c][0];
+                const double* c1 = rows[c][1];
+                V p0 = V::Select(upper, V::Set1(c0[degree]), V::Set1(c1[degree]));
+                V p1 = zero;
+                V p2 = zero;
+                for (int k = degree - 1; k >= 0; --k)
+                {
+                    if (nbDeriv >= 2)
+                    {
+                        p2 = p2 * x + p1;
+                    }
+                    if (nbDeriv >= 1)
+                    {
+                        p1 = p1 * x + p0;
+                    }
+                    p0 = p0 * x + V::Select(upper, V::Set1(c0[k]), V::Set1(c1[k]));
+                }
+                r[0][c] = p0;
+                r[1][c] = p1;
+                r[2][c] = two * p2;
+            }
+
+            if (monomials.rational)
+            {
+                Quotient(nbDeriv, r);
+            }
+            StoreBlock(r, nbDeriv, d, first, count, buffer);
+        }
+    }
+}
+
+#endif
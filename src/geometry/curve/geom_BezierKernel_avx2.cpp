@@ -0,0 +1,43 @@
+// AVX2 implementation of the Bezier batch kernels, 4 parameters per instruction.
+// This file is compiled with the AVX2 instruction set and only called when the CPU supports it.
+
+#include "geom_BezierKernelImpl.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace
+{
+    struct AVX2V
+    {
+        using Mask = __m256d;
+        static constexpr int Width = 4;
+        __m256d v;
+
+        static AVX2V Load(const double* p) { return {_mm256_loadu_pd(p)}; }
+        static AVX2V Set1(const double a) { return {_mm256_set1_pd(a)}; }
+        static Mask Greater(const AVX2V a, const AVX2V b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ); }
+        static AVX2V Select(const Mask m, const AVX2V a, const AVX2V b) { return {_mm256_blendv_pd(a.v, b.v, m)}; }
+        void Store(double* p) const { _mm256_storeu_pd(p, v); }
+
+        friend AVX2V operator+(const AVX2V a, const AVX2V b) { return {_mm256_add_pd(a.v, b.v)}; }
+        friend AVX2V operator-(const AVX2V a, const AVX2V b) { return {_mm256_sub_pd(a.v, b.v)}; }
+        friend AVX2V operator*(const AVX2V a, const AVX2V b) { return {_mm256_mul_pd(a.v, b.v)}; }
+        friend AVX2V operator/(const AVX2V a, const AVX2V b) { return {_mm256_div_pd(a.v, b.v)}; }
+    };
+}
+
+const Geom_BezierKernelData::Implementation* Geom_BezierKernelData::AVX2()
+{
+    static const Implementation implementation = {&EvaluateBatchImpl<AVX2V>, &EvaluateMonomialBatchImpl<AVX2V>, &EvaluatePackImpl<AVX2V>};
+    return &implementation;
+}
+
+#else
+
+const Geom_BezierKernelData::Implementation* Geom_BezierKernelData::AVX2()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,43 @@
+// AVX-512 implementation of the Bezier batch kernels, 8 parameters per instruction.
+// This file is compiled with the AVX-512 instruction set and only called when the CPU supports it.
+
+#include "geom_BezierKernelImpl.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace
+{
+    struct AVX512V
+    {
+        using Mask = __mmask8;
+        static constexpr int Width = 8;
+        __m512d v;
+
+        static AVX512V Load(const double* p) { return {_mm512_loadu_pd(p)}; }
+        static AVX512V Set1(const double a) { return {_mm512_set1_pd(a)}; }
+        static Mask Greater(const AVX512V a, const AVX512V b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ); }
+        static AVX512V Select(const Mask m, const AVX512V a, const AVX512V b) { return {_mm512_mask_blend_pd(m, a.v, b.v)}; }
+        void Store(double* p) const { _mm512_storeu_pd(p, v); }
+
+        friend AVX512V operator+(const AVX512V a, const AVX512V b) { return {_mm512_add_pd(a.v, b.v)}; }
+        friend AVX512V operator-(const AVX512V a, const AVX512V b) { return {_mm512_sub_pd(a.v, b.v)}; }
+        friend AVX512V operator*(const AVX512V a, const AVX512V b) { return {_mm512_mul_pd(a.v, b.v)}; }
+        friend AVX512V operator/(const AVX512V a, const AVX512V b) { return {_mm512_div_pd(a.v, b.v)}; }
+    };
+}
+
+const Geom_BezierKernelData::Implementation* Geom_BezierKernelData::AVX512()
+{
+    static const Implementation implementation = {&EvaluateBatchImpl<AVX512V>, &EvaluateMonomialBatchImpl<AVX512V>, &EvaluatePackImpl<AVX512V>};
+    return &implementation;
+}
+
+#else
+
+const Geom_BezierKernelData::Implementation* Geom_BezierKernelData::AVX512()
+{
+    return nullptr;
+}
+
+#endif
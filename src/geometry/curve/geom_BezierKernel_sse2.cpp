@@ -0,0 +1,42 @@
+// SSE2 implementation of the Bezier batch kernels, 2 parameters per instruction.
+
+#include "geom_BezierKernelImpl.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+
+namespace
+{
+    struct SSE2V
+    {
+        using Mask = __m128d;
+        static constexpr int Width = 2;
+        __m128d v;
+
+        static SSE2V Load(const double* p) { return {_mm_loadu_pd(p)}; }
+        static SSE2V Set1(const double a) { return {_mm_set1_pd(a)}; }
+        static Mask Greater(const SSE2V a, const SSE2V b) { return _mm_cmpgt_pd(a.v, b.v); }
+        static SSE2V Select(const Mask m, const SSE2V a, const SSE2V b) { return {_mm_or_pd(_mm_and_pd(m, b.v), _mm_andnot_pd(m, a.v))}; }
+        void Store(double* p) const { _mm_storeu_pd(p, v); }
+
+        friend SSE2V operator+(const SSE2V a, const SSE2V b) { return {_mm_add_pd(a.v, b.v)}; }
+        friend SSE2V operator-(const SSE2V a, const SSE2V b) { return {_mm_sub_pd(a.v, b.v)}; }
+        friend SSE2V operator*(const SSE2V a, const SSE2V b) { return {_mm_mul_pd(a.v, b.v)}; }
+        friend SSE2V operator/(const SSE2V a, const SSE2V b) { return {_mm_div_pd(a.v, b.v)}; }
+    };
+}
+
+const Geom_BezierKernelData::Implementation* Geom_BezierKernelData::SSE2()
+{
+    static const Implementation implementation = {&EvaluateBatchImpl<SSE2V>, &EvaluateMonomialBatchImpl<SSE2V>, &EvaluatePackImpl<SSE2V>};
+    return &implementation;
+}
+
+#else
+
+const Geom_BezierKernelData::Implementation* Geom_BezierKernelData::SSE2()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,233 @@
+#include "geom_BezierSampler.h"
+#include "exceptions.h"
+
+#include <algorithm>
+
+namespace
+{
+    using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+}
+
+Geom_BezierSampler::Geom_BezierSampler(const double* params, const int nbParams)
+{
+    VALIDATE_ARGUMENT(nbParams < 1, "nbParams", "Geom_BezierSampler: Number of parameters is lower than 1!");
+
+    m_params.assign(params, params + nbParams);
+    for (auto& bernstein : m_bernstein)
+    {
+        for (auto& basis : bernstein)
+        {
+            basis.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+Geom_BezierSampler::~Geom_BezierSampler()
+{
+    for (auto& bernstein : m_bernstein)
+    {
+        for (auto& basis : bernstein)
+        {
+            delete basis.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+Geom_BezierSampler Geom_BezierSampler::Uniform(const int nbParams)
+{
+    VALIDATE_ARGUMENT(nbParams < 2, "nbParams", "Geom_BezierSampler: Number of parameters is lower than 2!");
+
+    std::vector<double> params(nbParams);
+    for (int s = 0; s < nbParams; ++s)
+    {
+        params[s] = static_cast<double>(s) / (nbParams - 1);
+    }
+    return Geom_BezierSampler(params.data(), nbParams);
+}
+
+const Geom_BezierSampler::Basis& Geom_BezierSampler::Bernstein(const int degree, const int order) const
+{
+    VALIDATE_ARGUMENT_RANGE(degree, 1, Geom_BezierCurve::MaxDegree());
+    VALIDATE_ARGUMENT_RANGE(order, 0, 1);
+
+    std::atomic<const Basis*>& cache = m_bernstein[order][degree];
+    if (const Basis* basis = cache.load(std::memory_order_acquire))
+    {
+        return *basis;
+    }
+
+    // The derivative of the polynomial j is degree * (b[j - 1] - b[j]) from the polynomials of degree - 1.
+    Basis* built = new Basis(NbParams(), degree + 1);
+    double b[Geom_BezierKernel::MaxNbPoles];
+    for (int s = 0; s < NbParams(); ++s)
+    {
+        if (order == 0)
+        {
+            Geom_BezierKernel::Bernstein(degree, m_params[s], b);
+            for (int j = 0; j <= degree; ++j)
+            {
+                (*built)(s, j) = b[j];
+            }
+        }
+        else
+        {
+            Geom_BezierKernel::Bernstein(degree - 1, m_params[s], b);
+            for (int j = 0; j <= degree; ++j)
+            {
+                const double left = j > 0 ? b[j - 1] : 0.0;
+                const double right = j < degree ? b[j] : 0.0;
+                (*built)(s, j) = degree * (left - right);
+            }
+        }
+    }
+
+    // Concurrent readers may build the matrix at the same time: the first published wins.
+    const Basis* expected = nullptr;
+    if (cache.compare_exchange_strong(expected, built, std::memory_order_acq_rel))
+    {
+        return *built;
+    }
+    delete built;
+    return *expected;
+}
+
+void Geom_BezierSampler::D0(const Geom_BezierCurveSet& set, const gp_SoAOfXYZ& p) const
+{
+    Evaluate(set, 0, &p);
+}
+
+void Geom_BezierSampler::D1(const Geom_BezierCurveSet& set, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const
+{
+    const gp_SoAOfXYZ d[2] = {p, v1};
+    Evaluate(set, 1, d);
+}
+
+void Geom_BezierSampler::Evaluate(const Geom_BezierCurveSet& set, const int nbDeriv, const gp_SoAOfXYZ* d) const
+{
+    const int nbParams = NbParams();
+
+    // Group the curves by degree and rationality, one product per group.
+    std::vector<int> order(set.NbCurves());
+    for (int i = 0; i < set.NbCurves(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&set](const int a, const int b)
+    {
+        if (set.Degree(a) != set.Degree(b))
+        {
+            return set.Degree(a) < set.Degree(b);
+        }
+        return !set.IsRational(a) && set.IsRational(b);
+    });
+
+    RowMatrix poles;
+    RowMatrix values[2];
+    for (int first = 0; first < set.NbCurves();)
+    {
+        const int degree = set.Degree(order[first]);
+        const bool rational = set.IsRational(order[first]);
+        int last = first + 1;
+        while (last < set.NbCurves() && set.Degree(order[last]) == degree && set.IsRational(order[last]) == rational)
+        {
+            ++last;
+        }
+
+        // The row c * nbCurves + k holds the coordinate c of the poles of the curve k of the group,
+        // homogeneous for rational curves.
+        const int nbCurves = last - first;
+        const int dim = rational ? 4 : 3;
+        poles.resize(dim * nbCurves, degree + 1);
+        for (int k = 0; k < nbCurves; ++k)
+        {
+            const Geom_BezierCurveView curve = set.Curve(order[first + k]);
+            for (int j = 0; j <= degree; ++j)
+            {
+                const double w = curve.Weight(j);
+                const gp_Pnt& pole = curve.Pole(j);
+                poles(k, j) = w * pole.x;
+                poles(nbCurves + k, j) = w * pole.y;
+                poles(2 * nbCurves + k, j) = w * pole.z;
+                if (rational)
+                {
+                    poles(3 * nbCurves + k, j) = w;
+                }
+            }
+        }
+
+        // Consecutive non-rational curves of the set are written in place, the rows of their coordinates
+        // at all the parameters follow each other in the buffers.
+        if (!rational && order[last - 1] - order[first] == nbCurves - 1)
+        {
+            const int offset = order[first] * nbParams;
+            for (int n = 0; n <= nbDeriv; ++n)
+            {
+                const Basis& bernstein = Bernstein(degree, n);
+                double* coordinates[3] = {d[n].x + offset, d[n].y + offset, d[n].z + offset};
+                for (int c = 0; c < 3; ++c)
+                {
+                    Eigen::Map<RowMatrix> result(coordinates[c], nbCurves, nbParams);
+                    result.noalias() = poles.middleRows(c * nbCurves, nbCurves) * bernstein.transpose();
+                }
+            }
+            first = last;
+            continue;
+        }
+
+        // The row c * nbCurves + k of the products holds the coordinate c of the curve k at all the parameters.
+        for (int n = 0; n <= nbDeriv; ++n)
+        {
+            values[n].resize(dim * nbCurves, nbParams);
+            values[n].noalias() = poles * Bernstein(degree, n).transpose();
+        }
+
+        for (int k = 0; k < nbCurves; ++k)
+        {
+            const int offset = order[first + k] * nbParams;
+            const double* x = values[0].row(k).data();
+            const double* y = values[0].row(nbCurves + k).data();
+            const double* z = values[0].row(2 * nbCurves + k).data();
+            if (!rational)
+            {
+                std::copy(x, x + nbParams, d[0].x + offset);
+                std::copy(y, y + nbParams, d[0].y + offset);
+                std::copy(z, z + nbParams, d[0].z + offset);
+                if (nbDeriv > 0)
+                {
+                    const double* dx = values[1].row(k).data();
+                    const double* dy = values[1].row(nbCurves + k).data();
+                    const double* dz = values[1].row(2 * nbCurves + k).data();
+                    std::copy(dx, dx + nbParams, d[1].x + offset);
+                    std::copy(dy, dy + nbParams, d[1].y + offset);
+                    std::copy(dz, dz + nbParams, d[1].z + offset);
+                }
+                continue;
+            }
+
+            // Quotient rule: C = A / w and C' = (A' - w' * C) / w.
+            const double* w = values[0].row(3 * nbCurves + k).data();
+            for (int s = 0; s < nbParams; ++s)
+            {
+                const double inverse = 1.0 / w[s];
+                d[0].x[offset + s] = x[s] * inverse;
+                d[0].y[offset + s] = y[s] * inverse;
+                d[0].z[offset + s] = z[s] * inverse;
+            }
+            if (nbDeriv > 0)
+            {
+                const double* dx = values[1].row(k).data();
+                const double* dy = values[1].row(nbCurves + k).data();
+                const double* dz = values[1].row(2 * nbCurves + k).data();
+                const double* dw = values[1].row(3 * nbCurves + k).data();
+                for (int s = 0; s < nbParams; ++s)
+                {
+                    const double inverse = 1.0 / w[s];
+                    d[1].x[offset + s] = (dx[s] - dw[s] * d[0].x[offset + s]) * inverse;
+                    d[1].y[offset + s] = (dy[s] - dw[s] * d[0].y[offset + s]) * inverse;
+                    d[1].z[offset + s] = (dz[s] - dw[s] * d[0].z[offset + s]) * inverse;
+                }
+            }
+        }
+        first = last;
+    }
+}
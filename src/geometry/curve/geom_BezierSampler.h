@@ -0,0 +1,71 @@
+// Evaluation of many Bezier curves at a fixed set of parameters as matrix products.
+// The points of the curves of degree n at the M parameters are B * P, where B is the M x (n + 1)
+// matrix of the Bernstein polynomials at the parameters and P holds the poles of all the curves in its columns.
+// The matrices B are computed once per degree and per derivative for the parameters of the sampler,
+// and the products run in the blocked matrix multiplication of Eigen.
+
+#ifndef GEOM_BEZIERSAMPLER_H
+#define GEOM_BEZIERSAMPLER_H
+
+#include "geom_BezierCurveSet.h"
+
+#include <Eigen/Core>
+#include <atomic>
+
+class Geom_BezierSampler
+{
+public:
+    // Matrix of the values of the Bernstein polynomials (or of their derivatives) of a degree n:
+    // the coefficient (s, j) is the polynomial j at the parameter s.
+    using Basis = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>;
+
+    // Creates the sampler of the nbParams parameters params.
+    // Raised if nbParams is lower than 1.
+    Geom_BezierSampler(const double* params, const int nbParams);
+
+    ~Geom_BezierSampler();
+
+    Geom_BezierSampler(const Geom_BezierSampler&) = delete;
+    Geom_BezierSampler& operator=(const Geom_BezierSampler&) = delete;
+
+    // Creates the sampler of nbParams parameters uniformly distributed in [0, 1].
+    // Raised if nbParams is lower than 2.
+    static Geom_BezierSampler Uniform(const int nbParams);
+
+    // Returns the number of parameters.
+    inline int NbParams() const
+    {
+        return static_cast<int>(m_params.size());
+    }
+
+    // Returns the parameters.
+    inline const double* Params() const
+    {
+        return m_params.data();
+    }
+
+    // Returns the matrix of the Bernstein polynomials of the degree (order = 0), or of their first derivatives (order = 1),
+    // at the parameters. The matrix is computed on first use and shared by the later calls, from any thread.
+    // Raised if degree is not in the range [1, Geom_BezierCurve::MaxDegree()] or if order is not 0 or 1.
+    const Basis& Bernstein(const int degree, const int order) const;
+
+    // Computes the points of all the curves of the set at the parameters.
+    // The point of the curve i at the parameter s is stored at the index i * NbParams() + s,
+    // the buffers of p must hold set.NbCurves() * NbParams() values.
+    void D0(const Geom_BezierCurveSet& set, const gp_SoAOfXYZ& p) const;
+
+    // Computes the points and the first derivatives of all the curves of the set at the parameters, see D0.
+    void D1(const Geom_BezierCurveSet& set, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const;
+
+private:
+    // Evaluates the curves of the set up to the derivative nbDeriv (nbDeriv <= 1).
+    void Evaluate(const Geom_BezierCurveSet& set, const int nbDeriv, const gp_SoAOfXYZ* d) const;
+
+private:
+    std::vector<double> m_params;
+
+    // Matrices per order and degree, built on first use.
+    mutable std::atomic<const Basis*> m_bernstein[2][Geom_BezierKernel::MaxNbPoles];
+};
+
+#endif
@@ -5,4 +5,50 @@ gp_Pnt Geom_Curve::Value(const double u) const
     gp_Pnt p;
     D0(u, p);
     return p;
-}
\ No newline at end of file
+}
+
+void Geom_Curve::Derivatives(const double u, const int n, gp_Vec* d) const
+{
+    gp_Pnt pnt;
+    D0(u, pnt);
+    d[0] = pnt;
+    for (int k = 1; k <= n; ++k)
+    {
+        d[k] = DN(u, k);
+    }
+}
+
+void Geom_Curve::D0Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p) const
+{
+    gp_Pnt pnt;
+    for (int i = 0; i < nbParams; ++i)
+    {
+        D0(params[i], pnt);
+        p.SetValue(i, pnt);
+    }
+}
+
+void Geom_Curve::D1Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const
+{
+    gp_Pnt pnt;
+    gp_Vec d1;
+    for (int i = 0; i < nbParams; ++i)
+    {
+        D1(params[i], pnt, d1);
+        p.SetValue(i, pnt);
+        v1.SetValue(i, d1);
+    }
+}
+
+void Geom_Curve::D2Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1, const gp_SoAOfXYZ& v2) const
+{
+    gp_Pnt pnt;
+    gp_Vec d1, d2;
+    for (int i = 0; i < nbParams; ++i)
+    {
+        D2(params[i], pnt, d1, d2);
+        p.SetValue(i, pnt);
+        v1.SetValue(i, d1);
+        v2.SetValue(i, d2);
+    }
+}
@@ -9,6 +9,8 @@
 class Geom_Curve
 {
 public:
+    virtual ~Geom_Curve() = default;
+
     // Returns the value of the first parameter.
     virtual double FirstParameter() const = 0;
 
@@ -36,6 +38,27 @@ public:
     // Raised if the continuity of the curve is not CN.
     virtual gp_Vec DN(const double u, const int n) const = 0;
 
+    // Computes the point d[0] and the derivatives d[1], ..., d[n] of parameter u.
+    // The buffer d must hold at least n + 1 vectors.
+    // The default implementation calls D0 and DN for each order, subclasses
+    // override it to compute all the orders from a single evaluation.
+    // Raised if the continuity of the curve is not CN.
+    virtual void Derivatives(const double u, const int n, gp_Vec* d) const;
+
+    // Computes the points of the nbParams parameters params and stores them in p.
+    // The buffers of p must hold at least nbParams values.
+    // The default implementation calls D0 for each parameter, subclasses
+    // override it to share the dispatch and the setup across the whole batch.
+    virtual void D0Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p) const;
+
+    // Computes the points and the first derivatives of the nbParams parameters params.
+    // Raised if the continuity of the curve is not C1.
+    virtual void D1Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1) const;
+
+    // Computes the points, the first and second derivatives of the nbParams parameters params.
+    // Raised if the continuity of the curve is not C2.
+    virtual void D2Batch(const double* params, const int nbParams, const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& v1, const gp_SoAOfXYZ& v2) const;
+
     // Returns true if the degree of continuity of this curve is at least N.
     virtual bool IsCN(const int n) const = 0;
 
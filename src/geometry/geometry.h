@@ -29,9 +29,38 @@ using gp_Vec = glm::vec<3, double>;
 // Defines a non-persistent vector in 2D space.
 using gp_Vec2d = glm::vec<2, double>;
 
+// Defines a 3D point in homogeneous coordinates (w*x, w*y, w*z, w).
+using gp_Pnt4d = glm::vec<4, double>;
+
 // Defines a 3D cartesian point sequence.
 using gp_Array1OfPnt = std::vector<gp_Pnt>;
 
+// Defines a 3D homogeneous point sequence.
+using gp_Array1OfPnt4d = std::vector<gp_Pnt4d>;
+
+// Defines a non-persistent structure of arrays on caller-provided buffers of x, y and z coordinates.
+// It is used to write many points or vectors at once without an array of gp_Pnt in between.
+struct gp_SoAOfXYZ
+{
+    double* x;
+    double* y;
+    double* z;
+
+    // Stores the coordinates of v at the index i.
+    inline void SetValue(const int i, const gp_Vec& v) const
+    {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+
+    // Returns the coordinates stored at the index i.
+    inline gp_Vec Value(const int i) const
+    {
+        return gp_Vec(x[i], y[i], z[i]);
+    }
+};
+
 
 // Defines some constants for geometric computations.
 // -------------------------------------------------
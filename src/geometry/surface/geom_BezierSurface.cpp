@@ -0,0 +1,423 @@
+#include "geom_BezierSurface.h"
+#include "exceptions.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr int MaxNbPoles = Geom_BezierKernel::MaxNbPoles;
+
+    // Returns the binomial coefficient C(n, k), from the table for the orders of the poles.
+    double Binomial(const int n, const int k)
+    {
+        if (n < MaxNbPoles)
+        {
+            return Geom_BezierKernel::Binomial(n, k);
+        }
+        double binomial = 1.0;
+        for (int i = 1; i <= k; ++i)
+        {
+            binomial = binomial * (n - k + i) / i;
+        }
+        return binomial;
+    }
+}
+
+Geom_BezierSurface::Geom_BezierSurface(const gp_Array1OfPnt& poles, const int nbUPoles, const int nbVPoles)
+{
+    Init(poles, nullptr, nbUPoles, nbVPoles);
+}
+
+Geom_BezierSurface::Geom_BezierSurface(const gp_Array1OfPnt& poles, const std_Array1OfReal& weights, const int nbUPoles, const int nbVPoles)
+{
+    // Check weights
+    VALIDATE_ARGUMENT(weights.size() != poles.size(), "weights", "Geom_BezierSurface: Weights size does not match poles!");
+
+    bool rational = false;
+    for (size_t i = 0; i < weights.size(); ++i)
+    {
+        VALIDATE_ARGUMENT(weights[i] <= gp_Resolution, "weights", "Geom_BezierSurface: Some weights are near zero!");
+        rational = rational || std::abs(weights[i] - weights[0]) > gp_Resolution;
+    }
+
+    // Init, weights are only kept for a rational surface
+    Init(poles, rational ? weights.data() : nullptr, nbUPoles, nbVPoles);
+}
+
+void Geom_BezierSurface::Init(const gp_Array1OfPnt& poles, const double* weights, const int nbUPoles, const int nbVPoles)
+{
+    // Check poles
+    VALIDATE_ARGUMENT(nbUPoles < 2 || nbUPoles > MaxDegree() + 1, "nbUPoles", "Geom_BezierSurface: Number of poles in u is less than 2 or more than MaxDegree() + 1!");
+    VALIDATE_ARGUMENT(nbVPoles < 2 || nbVPoles > MaxDegree() + 1, "nbVPoles", "Geom_BezierSurface: Number of poles in v is less than 2 or more than MaxDegree() + 1!");
+    VALIDATE_ARGUMENT(static_cast<int>(poles.size()) != nbUPoles * nbVPoles, "poles", "Geom_BezierSurface: Poles size does not match the grid!");
+
+    m_nbUPoles = nbUPoles;
+    m_nbVPoles = nbVPoles;
+    m_poles = poles;
+
+    // Rational poles are stored in homogeneous coordinates for the evaluation
+    m_wpoles.clear();
+    if (weights)
+    {
+        m_wpoles.resize(poles.size());
+        for (size_t i = 0; i < poles.size(); ++i)
+        {
+            m_wpoles[i] = gp_Pnt4d(weights[i] * poles[i], weights[i]);
+        }
+    }
+
+    // Check closed
+    m_uClosed = true;
+    for (int j = 0; j < nbVPoles; ++j)
+    {
+        m_uClosed = m_uClosed && glm::distance(Pole(0, j), Pole(UDegree(), j)) <= Precision::Confusion();
+    }
+    m_vClosed = true;
+    for (int i = 0; i < nbUPoles; ++i)
+    {
+        m_vClosed = m_vClosed && glm::distance(Pole(i, 0), Pole(i, VDegree())) <= Precision::Confusion();
+    }
+}
+
+void Geom_BezierSurface::Bounds(double& u1, double& u2, double& v1, double& v2) const
+{
+    u1 = 0.0;
+    u2 = 1.0;
+    v1 = 0.0;
+    v2 = 1.0;
+}
+
+void Geom_BezierSurface::Evaluate(const double u, const double v, const int nbDeriv, gp_Vec* d) const
+{
+    const int p = UDegree(), q = VDegree();
+
+    // The column curves and their u derivatives at u.
+    gp_Pnt4d column[MaxNbPoles];
+    gp_Pnt4d q0[MaxNbPoles], q1[MaxNbPoles], q2[MaxNbPoles];
+    for (int j = 0; j <= q; ++j)
+    {
+        for (int i = 0; i <= p; ++i)
+        {
+            column[i] = HomogeneousPole(i, j);
+        }
+        gp_Pnt4d c[3];
+        Geom_BezierKernel::Casteljau(column, p, u, nbDeriv, c);
+        q0[j] = c[0];
+        if (nbDeriv >= 1)
+        {
+            q1[j] = c[1];
+        }
+        if (nbDeriv >= 2)
+        {
+            q2[j] = c[2];
+        }
+    }
+
+    // a: A, Av, Avv; au: Au, Auv; auu: Auu.
+    gp_Pnt4d a[3], au[2], auu;
+    Geom_BezierKernel::Casteljau(q0, q, v, nbDeriv, a);
+    if (nbDeriv >= 1)
+    {
+        Geom_BezierKernel::Casteljau(q1, q, v, nbDeriv - 1, au);
+    }
+    if (nbDeriv >= 2)
+    {
+        Geom_BezierKernel::Casteljau(q2, q, v, 0, &auu);
+    }
+
+    // Quotient rule, the weight derivatives vanish for a non-rational surface.
+    const double invW = 1.0 / a[0].w;
+    const gp_Vec s = gp_Vec(a[0]) * invW;
+    d[0] = s;
+    if (nbDeriv >= 1)
+    {
+        d[1] = (gp_Vec(au[0]) - au[0].w * s) * invW;
+        d[2] = (gp_Vec(a[1]) - a[1].w * s) * invW;
+    }
+    if (nbDeriv >= 2)
+    {
+        d[3] = (gp_Vec(auu) - 2.0 * au[0].w * d[1] - auu.w * s) * invW;
+        d[4] = (gp_Vec(a[2]) - 2.0 * a[1].w * d[2] - a[2].w * s) * invW;
+        d[5] = (gp_Vec(au[1]) - au[0].w * d[2] - a[1].w * d[1] - au[1].w * s) * invW;
+    }
+}
+
+gp_Pnt4d Geom_BezierSurface::HomogeneousDN(const double u, const double v, const int nu, const int nv) const
+{
+    const int p = UDegree(), q = VDegree();
+    if (nu > p || nv > q)
+    {
+        return gp_Pnt4d(0.0);
+    }
+
+    // Differences of the poles scaled by p! / (p - nu)! and q! / (q - nv)!.
+    gp_Pnt4d h[MaxNbPoles][MaxNbPoles];
+    for (int i = 0; i <= p; ++i)
+    {
+        for (int j = 0; j <= q; ++j)
+        {
+            h[i][j] = HomogeneousPole(i, j);
+        }
+    }
+    for (int k = 1; k <= nu; ++k)
+    {
+        for (int i = 0; i <= p - k; ++i)
+        {
+            for (int j = 0; j <= q; ++j)
+            {
+                h[i][j] = double(p - k + 1) * (h[i + 1][j] - h[i][j]);
+            }
+        }
+    }
+    for (int k = 1; k <= nv; ++k)
+    {
+        for (int i = 0; i <= p - nu; ++i)
+        {
+            for (int j = 0; j <= q - k; ++j)
+            {
+                h[i][j] = double(q - k + 1) * (h[i][j + 1] - h[i][j]);
+            }
+        }
+    }
+
+    gp_Pnt4d column[MaxNbPoles], points[MaxNbPoles];
+    for (int j = 0; j <= q - nv; ++j)
+    {
+        for (int i = 0; i <= p - nu; ++i)
+        {
+            column[i] = h[i][j];
+        }
+        Geom_BezierKernel::Casteljau(column, p - nu, u, 0, &points[j]);
+    }
+    gp_Pnt4d a;
+    Geom_BezierKernel::Casteljau(points, q - nv, v, 0, &a);
+    return a;
+}
+
+void Geom_BezierSurface::D0(const double u, const double v, gp_Pnt& p) const
+{
+    Evaluate(u, v, 0, &p);
+}
+
+void Geom_BezierSurface::D1(const double u, const double v, gp_Pnt& p, gp_Vec& d1u, gp_Vec& d1v) const
+{
+    gp_Vec d[3];
+    Evaluate(u, v, 1, d);
+    p = d[0];
+    d1u = d[1];
+    d1v = d[2];
+}
+
+void Geom_BezierSurface::D2(const double u, const double v, gp_Pnt& p, gp_Vec& d1u, gp_Vec& d1v,
+                            gp_Vec& d2u, gp_Vec& d2v, gp_Vec& d2uv) const
+{
+    gp_Vec d[6];
+    Evaluate(u, v, 2, d);
+    p = d[0];
+    d1u = d[1];
+    d1v = d[2];
+    d2u = d[3];
+    d2v = d[4];
+    d2uv = d[5];
+}
+
+gp_Vec Geom_BezierSurface::DN(const double u, const double v, const int nu, const int nv) const
+{
+    VALIDATE_ARGUMENT(nu < 0 || nv < 0 || nu + nv < 1, "nu", "Geom_BezierSurface: Derivative orders are invalid!");
+
+    if (!IsRational())
+    {
+        return gp_Vec(HomogeneousDN(u, v, nu, nv));
+    }
+
+    // S(k, l) = (A(k, l) - Sum((i, j) != (0, 0)) C(k, i) C(l, j) w(i, j) S(k - i, l - j)) / w.
+    const int nbV = nv + 1;
+    std::vector<gp_Pnt4d> a((nu + 1) * nbV);
+    std::vector<gp_Vec> s((nu + 1) * nbV);
+    for (int k = 0; k <= nu; ++k)
+    {
+        for (int l = 0; l <= nv; ++l)
+        {
+            a[k * nbV + l] = HomogeneousDN(u, v, k, l);
+        }
+    }
+    for (int k = 0; k <= nu; ++k)
+    {
+        for (int l = 0; l <= nv; ++l)
+        {
+            gp_Vec value(a[k * nbV + l]);
+            for (int i = 0; i <= k; ++i)
+            {
+                for (int j = (i == 0) ? 1 : 0; j <= l; ++j)
+                {
+                    value -= Binomial(k, i) * Binomial(l, j) * a[i * nbV + j].w * s[(k - i) * nbV + l - j];
+                }
+            }
+            s[k * nbV + l] = value / a[0].w;
+        }
+    }
+    return s[nu * nbV + nv];
+}
+
+void Geom_BezierSurface::D0Grid(const double* uParams, const int nbU, const double* vParams, const int nbV, const gp_SoAOfXYZ& p) const
+{
+    EvaluateGrid(uParams, nbU, vParams, nbV, p, nullptr);
+}
+
+void Geom_BezierSurface::NormalGrid(const double* uParams, const int nbU, const double* vParams, const int nbV,
+                                    const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& n) const
+{
+    EvaluateGrid(uParams, nbU, vParams, nbV, p, &n);
+}
+
+void Geom_BezierSurface::EvaluateGrid(const double* uParams, const int nbU, const double* vParams, const int nbV,
+                                      const gp_SoAOfXYZ& p, const gp_SoAOfXYZ* n) const
+{
+    const int degreeU = UDegree(), degreeV = VDegree();
+    const int nbColumns = m_nbVPoles;
+    const int nbDeriv = n ? 1 : 0;
+    const int dim = IsRational() ? 4 : 3;
+
+    // The column curves at the u parameters: the coordinate c of the derivative k of the column j
+    // at the parameter i is columns[((k * 4 + c) * nbColumns + j) * nbU + i].
+    std::vector<double> columns((nbDeriv + 1) * 4 * nbColumns * nbU);
+    auto column = [&](const int k, const int c, const int j)
+    {
+        return columns.data() + ((k * 4 + c) * nbColumns + j) * nbU;
+    };
+
+    // The weights go through the kernel in the x row, the y and z rows are written to a scratch buffer.
+    std::vector<double> scratch(IsRational() ? 2 * nbU : 0);
+    Geom_BezierKernel::Poles poles;
+    poles.degree = degreeU;
+    poles.rational = false;
+    for (int j = 0; j < nbColumns; ++j)
+    {
+        for (int i = 0; i <= degreeU; ++i)
+        {
+            const gp_Pnt4d h = HomogeneousPole(i, j);
+            poles.x[i] = h.x;
+            poles.y[i] = h.y;
+            poles.z[i] = h.z;
+        }
+        const gp_SoAOfXYZ d[2] = {{column(0, 0, j), column(0, 1, j), column(0, 2, j)},
+                                  {column(nbDeriv, 0, j), column(nbDeriv, 1, j), column(nbDeriv, 2, j)}};
+        Geom_BezierKernel::EvaluateBatch(poles, uParams, nbU, nbDeriv, d);
+
+        if (IsRational())
+        {
+            for (int i = 0; i <= degreeU; ++i)
+            {
+                poles.x[i] = poles.y[i] = poles.z[i] = m_wpoles[i * m_nbVPoles + j].w;
+            }
+            const gp_SoAOfXYZ w[2] = {{column(0, 3, j), scratch.data(), scratch.data() + nbU},
+                                      {column(nbDeriv, 3, j), scratch.data(), scratch.data() + nbU}};
+            Geom_BezierKernel::EvaluateBatch(poles, uParams, nbU, nbDeriv, w);
+        }
+    }
+
+    // The Bernstein polynomials of the v parameters and their derivatives: the polynomial j
+    // at the parameter l is basis[j * nbV + l], its derivative is derivatives[j * nbV + l].
+    std::vector<double> basis(nbColumns * nbV), derivatives(nbDeriv ? nbColumns * nbV : 0);
+    double b[MaxNbPoles];
+    for (int l = 0; l < nbV; ++l)
+    {
+        Geom_BezierKernel::Bernstein(degreeV, vParams[l], b);
+        for (int j = 0; j <= degreeV; ++j)
+        {
+            basis[j * nbV + l] = b[j];
+        }
+        if (nbDeriv)
+        {
+            Geom_BezierKernel::Bernstein(degreeV - 1, vParams[l], b);
+            for (int j = 0; j <= degreeV; ++j)
+            {
+                derivatives[j * nbV + l] = degreeV * ((j > 0 ? b[j - 1] : 0.0) - (j < degreeV ? b[j] : 0.0));
+            }
+        }
+    }
+
+    // For each u, the curve of the column points at the v parameters: the homogeneous coordinate c
+    // of the point, of the u derivative and of the v derivative at the parameter l are a[c][l], au[c][l], av[c][l].
+    std::vector<double> sums(3 * 4 * nbV);
+    double* a[4] = {&sums[0], &sums[nbV], &sums[2 * nbV], &sums[3 * nbV]};
+    double* au[4] = {&sums[4 * nbV], &sums[5 * nbV], &sums[6 * nbV], &sums[7 * nbV]};
+    double* av[4] = {&sums[8 * nbV], &sums[9 * nbV], &sums[10 * nbV], &sums[11 * nbV]};
+    for (int i = 0; i < nbU; ++i)
+    {
+        std::fill(sums.begin(), sums.end(), 0.0);
+        for (int j = 0; j < nbColumns; ++j)
+        {
+            const double* bj = &basis[j * nbV];
+            for (int c = 0; c < dim; ++c)
+            {
+                const double value = column(0, c, j)[i];
+                double* ac = a[c];
+                for (int l = 0; l < nbV; ++l)
+                {
+                    ac[l] += bj[l] * value;
+                }
+            }
+            if (nbDeriv)
+            {
+                const double* dj = &derivatives[j * nbV];
+                for (int c = 0; c < dim; ++c)
+                {
+                    const double value = column(0, c, j)[i];
+                    const double valueU = column(1, c, j)[i];
+                    double* auc = au[c];
+                    double* avc = av[c];
+                    for (int l = 0; l < nbV; ++l)
+                    {
+                        auc[l] += bj[l] * valueU;
+                        avc[l] += dj[l] * value;
+                    }
+                }
+            }
+        }
+
+        // Quotient rule, the weight is 1 and its derivatives vanish for a non-rational surface.
+        for (int l = 0; l < nbV; ++l)
+        {
+            const double invW = IsRational() ? 1.0 / a[3][l] : 1.0;
+            const gp_Vec s = gp_Vec(a[0][l], a[1][l], a[2][l]) * invW;
+            p.SetValue(i * nbV + l, s);
+            if (nbDeriv)
+            {
+                gp_Vec du(au[0][l], au[1][l], au[2][l]);
+                gp_Vec dv(av[0][l], av[1][l], av[2][l]);
+                if (IsRational())
+                {
+                    du = (du - au[3][l] * s) * invW;
+                    dv = (dv - av[3][l] * s) * invW;
+                }
+                const gp_Vec normal = glm::cross(du, dv);
+                const double length = glm::length(normal);
+                n->SetValue(i * nbV + l, length > gp_Resolution ? normal / length : gp_Vec(0.0));
+            }
+        }
+    }
+}
+
+const gp_Pnt& Geom_BezierSurface::Pole(const int i, const int j) const
+{
+    // Check indices
+    VALIDATE_ARGUMENT_RANGE(i, 0, m_nbUPoles - 1);
+    VALIDATE_ARGUMENT_RANGE(j, 0, m_nbVPoles - 1);
+
+    return m_poles[i * m_nbVPoles + j];
+}
+
+double Geom_BezierSurface::Weight(const int i, const int j) const
+{
+    // Check indices
+    VALIDATE_ARGUMENT_RANGE(i, 0, m_nbUPoles - 1);
+    VALIDATE_ARGUMENT_RANGE(j, 0, m_nbVPoles - 1);
+
+    return IsRational() ? m_wpoles[i * m_nbVPoles + j].w : 1.0;
+}
+
+handle<Geom_Surface> Geom_BezierSurface::Copy() const
+{
+    return std::make_shared<Geom_BezierSurface>(*this);
+}
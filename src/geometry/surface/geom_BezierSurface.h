@@ -0,0 +1,166 @@
+// Describes a rational or non-rational Bezier surface
+// - a non-rational Bezier surface is defined by a grid of poles (also called control points),
+// - a rational Bezier surface is defined by a grid of poles with varying weights.
+// The pole (i, j) is the pole of range i in the u direction and j in the v direction, stored at the index
+// i * NbVPoles() + j. The weights are stored with the poles in homogeneous coordinates.
+// The surface is the tensor product S(u, v) = Sum(i, j) B(i, p)(u) B(j, q)(v) P(i, j), so the grids are
+// evaluated in two passes: the column curves of the poles P(., j) at all the u parameters with the curve
+// kernels, then for each u the curve of the column points at all the v parameters.
+
+#ifndef GEOM_BEZIERSURFACE_H
+#define GEOM_BEZIERSURFACE_H
+
+#include "geom_Surface.h"
+#include "curve/geom_BezierKernel.h"
+
+class Geom_BezierSurface: public Geom_Surface
+{
+public:
+    // Creates a non-rational Bezier surface with the grid of nbUPoles * nbVPoles poles.
+    // Raised if nbUPoles or nbVPoles is lower than 2 or greater than MaxDegree() + 1,
+    // or if poles does not hold nbUPoles * nbVPoles poles.
+    Geom_BezierSurface(const gp_Array1OfPnt& poles, const int nbUPoles, const int nbVPoles);
+
+    // Creates a rational Bezier surface with the grid of poles and the weights at the same indices.
+    // If all the weights are identical the surface is considered as non rational.
+    // Raised as above, if poles and weights don't have the same length,
+    // or if a weight is not greater than Resolution from package geometry.
+    Geom_BezierSurface(const gp_Array1OfPnt& poles, const std_Array1OfReal& weights, const int nbUPoles, const int nbVPoles);
+
+    // Returns the bounds [0, 1] x [0, 1].
+    void Bounds(double& u1, double& u2, double& v1, double& v2) const override;
+
+    inline bool IsUClosed() const override
+    {
+        return m_uClosed;
+    }
+
+    inline bool IsVClosed() const override
+    {
+        return m_vClosed;
+    }
+
+    // a Bezier surface is CN
+    Geom_Continuity Continuity() const override
+    {
+        return Geom_Continuity::Geom_CN;
+    }
+
+    inline bool IsCNu(const int /*n*/) const override
+    {
+        return true;
+    }
+
+    inline bool IsCNv(const int /*n*/) const override
+    {
+        return true;
+    }
+
+    void D0(const double u, const double v, gp_Pnt& p) const override;
+
+    void D1(const double u, const double v, gp_Pnt& p, gp_Vec& d1u, gp_Vec& d1v) const override;
+
+    void D2(const double u, const double v, gp_Pnt& p, gp_Vec& d1u, gp_Vec& d1v,
+            gp_Vec& d2u, gp_Vec& d2v, gp_Vec& d2uv) const override;
+
+    // The derivatives of a rational surface follow from the Leibniz rule in both directions.
+    gp_Vec DN(const double u, const double v, const int nu, const int nv) const override;
+
+    // Separable evaluation of the grid, in O(nbU * p * q + nbU * nbV * q) for the degrees p and q:
+    // the column curves at the u parameters, then the curves of the column points at the v parameters.
+    void D0Grid(const double* uParams, const int nbU, const double* vParams, const int nbV, const gp_SoAOfXYZ& p) const override;
+
+    // Separable evaluation of the grid with the first derivatives, see D0Grid.
+    void NormalGrid(const double* uParams, const int nbU, const double* vParams, const int nbV,
+                    const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& n) const override;
+
+    // Returns false if all the weights are identical.
+    inline bool IsRational() const
+    {
+        return !m_wpoles.empty();
+    }
+
+    // Returns the number of poles in the u direction.
+    inline int NbUPoles() const
+    {
+        return m_nbUPoles;
+    }
+
+    // Returns the number of poles in the v direction.
+    inline int NbVPoles() const
+    {
+        return m_nbVPoles;
+    }
+
+    // Returns the degree in the u direction.
+    inline int UDegree() const
+    {
+        return m_nbUPoles - 1;
+    }
+
+    // Returns the degree in the v direction.
+    inline int VDegree() const
+    {
+        return m_nbVPoles - 1;
+    }
+
+    // Returns the pole (i, j).
+    // Raised if i is not in the range [0, NbUPoles() - 1] or j not in [0, NbVPoles() - 1].
+    const gp_Pnt& Pole(const int i, const int j) const;
+
+    // Returns all the poles, the pole (i, j) at the index i * NbVPoles() + j.
+    inline const gp_Array1OfPnt& Poles() const
+    {
+        return m_poles;
+    }
+
+    // Returns the weight of the pole (i, j).
+    // Raised if i is not in the range [0, NbUPoles() - 1] or j not in [0, NbVPoles() - 1].
+    double Weight(const int i, const int j) const;
+
+    // Returns the value of the maximum polynomial degree of any Geom_BezierSurface in each direction. This value is 25.
+    constexpr static int MaxDegree()
+    {
+        return 25;
+    }
+
+    // Creates a new object which is a copy of this Bezier surface.
+    handle<Geom_Surface> Copy() const override;
+
+private:
+    // Checks the arguments and sets the surface. If weights is null the surface is non-rational.
+    void Init(const gp_Array1OfPnt& poles, const double* weights, const int nbUPoles, const int nbVPoles);
+
+    // Returns the homogeneous pole (i, j), of weight 1 for a non-rational surface.
+    inline gp_Pnt4d HomogeneousPole(const int i, const int j) const
+    {
+        const int index = i * m_nbVPoles + j;
+        return IsRational() ? m_wpoles[index] : gp_Pnt4d(m_poles[index], 1.0);
+    }
+
+    // Computes the point d[0], the first derivatives d[1] = d1u, d[2] = d1v (nbDeriv >= 1)
+    // and the second derivatives d[3] = d2u, d[4] = d2v, d[5] = d2uv (nbDeriv = 2) of the parameters (u, v)
+    // with the de Casteljau algorithm on the columns, then on the column points.
+    void Evaluate(const double u, const double v, const int nbDeriv, gp_Vec* d) const;
+
+    // Returns the derivative of order (nu, nv) of the homogeneous surface, from the differences of the poles.
+    gp_Pnt4d HomogeneousDN(const double u, const double v, const int nu, const int nv) const;
+
+    // Separable evaluation of the points of a grid and, if n is not null, of the unit normals.
+    void EvaluateGrid(const double* uParams, const int nbU, const double* vParams, const int nbV,
+                      const gp_SoAOfXYZ& p, const gp_SoAOfXYZ* n) const;
+
+private:
+    int m_nbUPoles;
+    int m_nbVPoles;
+    bool m_uClosed;
+    bool m_vClosed;
+
+    gp_Array1OfPnt m_poles;
+
+    // Poles of a rational surface in homogeneous coordinates (w*x, w*y, w*z, w),
+    // empty for a non-rational surface.
+    gp_Array1OfPnt4d m_wpoles;
+};
+
+#endif
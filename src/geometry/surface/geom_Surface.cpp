@@ -0,0 +1,39 @@
+#include "geom_Surface.h"
+
+gp_Pnt Geom_Surface::Value(const double u, const double v) const
+{
+    gp_Pnt p;
+    D0(u, v, p);
+    return p;
+}
+
+void Geom_Surface::D0Grid(const double* uParams, const int nbU, const double* vParams, const int nbV, const gp_SoAOfXYZ& p) const
+{
+    gp_Pnt pnt;
+    for (int i = 0; i < nbU; ++i)
+    {
+        for (int j = 0; j < nbV; ++j)
+        {
+            D0(uParams[i], vParams[j], pnt);
+            p.SetValue(i * nbV + j, pnt);
+        }
+    }
+}
+
+void Geom_Surface::NormalGrid(const double* uParams, const int nbU, const double* vParams, const int nbV,
+                              const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& n) const
+{
+    gp_Pnt pnt;
+    gp_Vec d1u, d1v;
+    for (int i = 0; i < nbU; ++i)
+    {
+        for (int j = 0; j < nbV; ++j)
+        {
+            D1(uParams[i], vParams[j], pnt, d1u, d1v);
+            const gp_Vec normal = glm::cross(d1u, d1v);
+            const double length = glm::length(normal);
+            p.SetValue(i * nbV + j, pnt);
+            n.SetValue(i * nbV + j, length > gp_Resolution ? normal / length : gp_Vec(0.0));
+        }
+    }
+}
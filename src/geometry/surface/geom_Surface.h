@@ -0,0 +1,68 @@
+// The abstract class Surface describes the common behavior of surfaces in 3D space.
+// A surface is defined by a parametric function S(u, v) on a rectangle of the (u, v) plane.
+
+#ifndef GEOM_SURFACE_H
+#define GEOM_SURFACE_H
+
+#include "geometry.h"
+#include "utils.h"
+
+class Geom_Surface
+{
+public:
+    virtual ~Geom_Surface() = default;
+
+    // Returns the parametric bounds u1, u2, v1, v2 of the surface.
+    virtual void Bounds(double& u1, double& u2, double& v1, double& v2) const = 0;
+
+    // Returns true if the surface is closed in the u direction.
+    virtual bool IsUClosed() const = 0;
+
+    // Returns true if the surface is closed in the v direction.
+    virtual bool IsVClosed() const = 0;
+
+    // Returns the global continuity of the surface.
+    virtual Geom_Continuity Continuity() const = 0;
+
+    // Returns true if the degree of continuity of the surface in the u direction is at least n.
+    virtual bool IsCNu(const int n) const = 0;
+
+    // Returns true if the degree of continuity of the surface in the v direction is at least n.
+    virtual bool IsCNv(const int n) const = 0;
+
+    // Returns in p the point of parameters (u, v).
+    virtual void D0(const double u, const double v, gp_Pnt& p) const = 0;
+
+    // Returns the point p of parameters (u, v) and the first derivatives d1u and d1v.
+    // Raised if the continuity of the surface is not C1.
+    virtual void D1(const double u, const double v, gp_Pnt& p, gp_Vec& d1u, gp_Vec& d1v) const = 0;
+
+    // Returns the point p of parameters (u, v), the first and second derivatives.
+    // Raised if the continuity of the surface is not C2.
+    virtual void D2(const double u, const double v, gp_Pnt& p, gp_Vec& d1u, gp_Vec& d1v,
+                    gp_Vec& d2u, gp_Vec& d2v, gp_Vec& d2uv) const = 0;
+
+    // Returns the derivative of order nu in the u direction and nv in the v direction.
+    // Raised if nu + nv < 1, nu < 0 or nv < 0.
+    virtual gp_Vec DN(const double u, const double v, const int nu, const int nv) const = 0;
+
+    // Computes the points of the grid of the nbU parameters uParams and the nbV parameters vParams.
+    // The point of parameters (uParams[i], vParams[j]) is stored at the index i * nbV + j,
+    // the buffers of p must hold nbU * nbV values.
+    // The default implementation calls D0 for each point of the grid.
+    virtual void D0Grid(const double* uParams, const int nbU, const double* vParams, const int nbV, const gp_SoAOfXYZ& p) const;
+
+    // Computes the points and the unit normals of the grid, see D0Grid. The normal is the normalized cross product
+    // of the first derivatives, a null vector where they are parallel.
+    // The default implementation calls D1 for each point of the grid.
+    virtual void NormalGrid(const double* uParams, const int nbU, const double* vParams, const int nbV,
+                            const gp_SoAOfXYZ& p, const gp_SoAOfXYZ& n) const;
+
+    // Creates a new object which is a copy of this surface.
+    virtual handle<Geom_Surface> Copy() const = 0;
+
+    // Computes the point of parameters (u, v).
+    gp_Pnt Value(const double u, const double v) const;
+};
+
+#endif
@@ -0,0 +1,147 @@
+#include "cpu.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CPU_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#ifdef CPU_X86
+namespace
+{
+    // Registers returned by the cpuid instruction for a leaf and a sub-leaf.
+    struct CPUIDRegisters
+    {
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    };
+
+    CPUIDRegisters CPUID(const unsigned int leaf, const unsigned int subLeaf)
+    {
+        CPUIDRegisters r;
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+        r.eax = info[0];
+        r.ebx = info[1];
+        r.ecx = info[2];
+        r.edx = info[3];
+#else
+        if (leaf > __get_cpuid_max(0, nullptr))
+        {
+            return r;
+        }
+        __cpuid_count(leaf, subLeaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+        return r;
+    }
+
+    // Returns the extended control register 0 telling which register states are saved by the operating system.
+    unsigned long long XCR0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned int eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+    }
+
+    // Features of the running processor, detected once.
+    struct Features
+    {
+        bool sse2 = false;
+        bool avx2 = false;
+        bool avx512 = false;
+
+        Features()
+        {
+            const CPUIDRegisters leaf1 = CPUID(1, 0);
+            sse2 = (leaf1.edx & (1u << 26)) != 0;
+
+            // AVX states need OSXSAVE and the XMM/YMM states enabled in XCR0.
+            const bool osxsave = (leaf1.ecx & (1u << 27)) != 0;
+            const bool avx = (leaf1.ecx & (1u << 28)) != 0;
+            if (!osxsave || !avx)
+            {
+                return;
+            }
+            const unsigned long long xcr0 = XCR0();
+            const bool ymmState = (xcr0 & 0x6) == 0x6;
+            const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+            const CPUIDRegisters leaf7 = CPUID(7, 0);
+            avx2 = ymmState && (leaf7.ebx & (1u << 5)) != 0;
+            avx512 = zmmState && (leaf7.ebx & (1u << 16)) != 0;
+        }
+    };
+
+    const Features& CPUFeatures()
+    {
+        static const Features features;
+        return features;
+    }
+}
+#endif
+
+bool CPU::HasSSE2()
+{
+#ifdef CPU_X86
+    return CPUFeatures().sse2;
+#else
+    return false;
+#endif
+}
+
+bool CPU::HasAVX2()
+{
+#ifdef CPU_X86
+    return CPUFeatures().avx2;
+#else
+    return false;
+#endif
+}
+
+bool CPU::HasAVX512()
+{
+#ifdef CPU_X86
+    return CPUFeatures().avx512;
+#else
+    return false;
+#endif
+}
+
+CPU_InstructionSet CPU::Best()
+{
+    if (HasAVX512())
+    {
+        return CPU_InstructionSet::CPU_AVX512;
+    }
+    if (HasAVX2())
+    {
+        return CPU_InstructionSet::CPU_AVX2;
+    }
+    if (HasSSE2())
+    {
+        return CPU_InstructionSet::CPU_SSE2;
+    }
+    return CPU_InstructionSet::CPU_Scalar;
+}
+
+bool CPU::Supports(const CPU_InstructionSet set)
+{
+    switch (set)
+    {
+    case CPU_InstructionSet::CPU_SSE2:
+        return HasSSE2();
+    case CPU_InstructionSet::CPU_AVX2:
+        return HasAVX2();
+    case CPU_InstructionSet::CPU_AVX512:
+        return HasAVX512();
+    default:
+        return true;
+    }
+}
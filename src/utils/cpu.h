@@ -0,0 +1,34 @@
+// The CPU package detects at runtime the instruction sets supported by the processor
+// and the operating system, so that vectorized kernels can select their implementation.
+
+#ifndef CPU_H
+#define CPU_H
+
+// Instruction sets of the vectorized kernels, from the narrowest to the widest.
+enum class CPU_InstructionSet
+{
+    CPU_Scalar, CPU_SSE2, CPU_AVX2, CPU_AVX512
+};
+
+class CPU
+{
+public:
+    // Returns true if SSE2 instructions can be used.
+    static bool HasSSE2();
+
+    // Returns true if AVX2 instructions can be used.
+    // The operating system must save the YMM registers.
+    static bool HasAVX2();
+
+    // Returns true if AVX-512 foundation instructions can be used.
+    // The operating system must save the ZMM and opmask registers.
+    static bool HasAVX512();
+
+    // Returns the widest instruction set that can be used.
+    static CPU_InstructionSet Best();
+
+    // Returns true if the instruction set can be used.
+    static bool Supports(const CPU_InstructionSet set);
+};
+
+#endif
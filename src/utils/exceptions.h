@@ -14,9 +14,14 @@
 	}
 
 #define VALIDATE_ARGUMENT_RANGE(arg, min, max)\
-	if((arg - min < -Precision::RealSmall()) || \
-	  (arg - max > Precision::RealSmall())){\
+	if(((arg) - (min) < -Precision::RealSmall()) || \
+	  ((arg) - (max) > Precision::RealSmall())){\
 		throw std::out_of_range("Argument is out of range["#min","#max"]\r\nParameter name: " #arg);\
 	}
 
+#define VALIDATE_FILE(condition, path, message)\
+	if(condition){\
+		throw std::runtime_error((std::string(message) + "\r\nFile name: " + path).c_str());\
+	}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "mappedFile.h"
+#include "exceptions.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path)
+    : m_data(nullptr),
+      m_size(0)
+{
+#if defined(_WIN32)
+    m_file = nullptr;
+    m_mapping = nullptr;
+    const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    VALIDATE_FILE(file == INVALID_HANDLE_VALUE, path, "MappedFile: Cannot open the file!");
+    m_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        Close();
+        VALIDATE_FILE(true, path, "MappedFile: Cannot read the size of the file!");
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size == 0)
+    {
+        return;
+    }
+
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_data = m_mapping ? static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+    if (!m_data)
+    {
+        Close();
+        VALIDATE_FILE(true, path, "MappedFile: Cannot map the file!");
+    }
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+    VALIDATE_FILE(file < 0, path, "MappedFile: Cannot open the file!");
+
+    struct stat status;
+    if (fstat(file, &status) != 0)
+    {
+        close(file);
+        VALIDATE_FILE(true, path, "MappedFile: Cannot read the size of the file!");
+    }
+    m_size = static_cast<size_t>(status.st_size);
+    if (m_size == 0)
+    {
+        close(file);
+        return;
+    }
+
+    // The mapping keeps its own reference to the file.
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, file, 0);
+    close(file);
+    VALIDATE_FILE(data == MAP_FAILED, path, "MappedFile: Cannot map the file!");
+    m_data = static_cast<const unsigned char*>(data);
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_size(std::exchange(other.m_size, 0))
+#if defined(_WIN32)
+      , m_file(std::exchange(other.m_file, nullptr)),
+      m_mapping(std::exchange(other.m_mapping, nullptr))
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#if defined(_WIN32)
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping)
+    {
+        CloseHandle(m_mapping);
+    }
+    if (m_file)
+    {
+        CloseHandle(m_file);
+    }
+    m_file = nullptr;
+    m_mapping = nullptr;
+#else
+    if (m_data)
+    {
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
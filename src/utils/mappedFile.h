@@ -0,0 +1,51 @@
+// The MappedFile package maps a whole file read-only into the address space. The pages are read from
+// the disk on their first access and shared with the page cache: opening a file costs no read and
+// no copy, and the mapping is released with the object.
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+class MappedFile
+{
+public:
+    // Maps the file of the path.
+    // Raised if the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    // Returns the first byte of the file, aligned on a page, null for an empty file.
+    inline const unsigned char* Data() const
+    {
+        return m_data;
+    }
+
+    // Returns the size of the file in bytes.
+    inline size_t Size() const
+    {
+        return m_size;
+    }
+
+private:
+    // Unmaps the file.
+    void Close();
+
+private:
+    const unsigned char* m_data;
+    size_t m_size;
+#if defined(_WIN32)
+    void* m_file;
+    void* m_mapping;
+#endif
+};
+
+#endif
@@ -0,0 +1,65 @@
+// The Parallel package runs the iterations of a loop on the hardware threads.
+// The iterations are handed out in chunks from a shared counter, so that the threads
+// which get cheap iterations take more chunks.
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class Parallel
+{
+public:
+    // Calls func(first, last) on chunks [first, last[ of at most grain iterations covering [0, nbIterations[,
+    // on up to NbThreads() threads including the calling one. The chunks of a thread are in increasing order.
+    // func must not throw.
+    template <typename Func>
+    static void For(const int nbIterations, const int grain, const Func& func);
+
+    // Returns the number of hardware threads, at least 1.
+    static int NbThreads()
+    {
+        return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+};
+
+template <typename Func>
+void Parallel::For(const int nbIterations, const int grain, const Func& func)
+{
+    const int chunk = std::max(1, grain);
+    const int nbChunks = (nbIterations + chunk - 1) / chunk;
+    const int nbThreads = std::min(NbThreads(), nbChunks);
+    if (nbThreads <= 1)
+    {
+        if (nbIterations > 0)
+        {
+            func(0, nbIterations);
+        }
+        return;
+    }
+
+    std::atomic<int> next(0);
+    auto run = [&]()
+    {
+        for (int first = next.fetch_add(chunk); first < nbIterations; first = next.fetch_add(chunk))
+        {
+            func(first, std::min(first + chunk, nbIterations));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < nbThreads; ++t)
+    {
+        threads.emplace_back(run);
+    }
+    run();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+#endif
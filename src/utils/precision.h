@@ -14,6 +14,7 @@
 #define PRECISION_H
 
 #include <cmath>
+#include <cfloat>
 
 class Precision
 {
@@ -92,7 +93,7 @@ public:
 
     // Returns true if <r> may be considered as a negative infinite number.
     // Currently r <= -1e100.
-    inline static bool IsPositiveInfinite(const double r)
+    inline static bool IsNegativeInfinite(const double r)
     {
         return r <= -(0.5 * Infinite());
     }
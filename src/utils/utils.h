@@ -1,6 +1,7 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <memory>
 #include <vector>
 
 // Type Definition
@@ -11,4 +12,6 @@ using handle = std::shared_ptr<Class>;
 
 using std_Array1OfReal = std::vector<double>;
 
+using std_Array1OfInteger = std::vector<int>;
+
 #endif
\ No newline at end of file
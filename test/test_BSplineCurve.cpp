@@ -0,0 +1,162 @@
+// Checks that the knot insertion and removal of B-spline curves keep the curves in place.
+
+#include "curve/geom_BSplineCurve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    // Builds a clamped curve of the given degree on the knots 0, 1, 2, 3, 4, the knot 2 being double,
+    // with poles on a helix and, if rational, varying weights.
+    Geom_BSplineCurve MakeCurve(const int degree, const bool rational)
+    {
+        const std_Array1OfReal knots = {0.0, 1.0, 2.0, 3.0, 4.0};
+        const std_Array1OfInteger multiplicities = {degree + 1, 1, 2, 1, degree + 1};
+        gp_Array1OfPnt poles;
+        std_Array1OfReal weights;
+        for (int i = 0; i < degree + 5; ++i)
+        {
+            poles.push_back(gp_Pnt(std::cos(0.7 * i), std::sin(0.7 * i), 0.3 * i - 0.02 * i * i));
+            weights.push_back(1.0 + 0.25 * (i % 3));
+        }
+        return rational ? Geom_BSplineCurve(poles, weights, knots, multiplicities, degree)
+                        : Geom_BSplineCurve(poles, knots, multiplicities, degree);
+    }
+
+    // Builds a clamped curve of the given degree on the uniform knots 0, 1, ..., 20, with poles close together
+    // on a helix and smoothly varying weights, whose knots can be removed with small displacements.
+    Geom_BSplineCurve MakeDenseCurve(const int degree, const bool rational)
+    {
+        std_Array1OfReal knots;
+        std_Array1OfInteger multiplicities;
+        for (int i = 0; i <= 20; ++i)
+        {
+            knots.push_back(i);
+            multiplicities.push_back(i == 0 || i == 20 ? degree + 1 : 1);
+        }
+        gp_Array1OfPnt poles;
+        std_Array1OfReal weights;
+        for (int i = 0; i < degree + 20; ++i)
+        {
+            poles.push_back(gp_Pnt(std::cos(0.2 * i), std::sin(0.2 * i), 0.1 * i));
+            weights.push_back(1.0 + 0.1 * std::sin(0.3 * i));
+        }
+        return rational ? Geom_BSplineCurve(poles, weights, knots, multiplicities, degree)
+                        : Geom_BSplineCurve(poles, knots, multiplicities, degree);
+    }
+
+    // Returns the largest distance between the points of the curves on a grid of their common bounds.
+    double Deviation(const Geom_BSplineCurve& curve, const Geom_BSplineCurve& other)
+    {
+        const int nbParams = 1001;
+        double deviation = 0.0;
+        for (int i = 0; i < nbParams; ++i)
+        {
+            const double u = curve.FirstParameter() + (curve.LastParameter() - curve.FirstParameter()) * i / (nbParams - 1);
+            gp_Pnt p, q;
+            curve.D0(u, p);
+            other.D0(u, q);
+            deviation = std::max(deviation, glm::distance(p, q));
+        }
+        return deviation;
+    }
+
+    // Returns the number of failed checks of the insertion of knots, then of their removal with a zero tolerance.
+    int CheckInsertRemove(const Geom_BSplineCurve& curve)
+    {
+        // Interior knots, a double one and one close to the last knot.
+        const double knots[] = {0.5, 1.5, 1.5, 2.25, 3.9};
+        const int nbKnots = 5;
+        const double tolerance = 1.e-12;
+        int nbErrors = 0;
+
+        Geom_BSplineCurve refined = curve;
+        refined.InsertKnots(knots, nbKnots);
+        if (refined.NbPoles() != curve.NbPoles() + nbKnots || Deviation(refined, curve) > tolerance)
+        {
+            std::printf("  InsertKnots: %d poles, deviation %g\n", refined.NbPoles(), Deviation(refined, curve));
+            ++nbErrors;
+        }
+
+        // The inserted knots are removed, not the knots of the curve.
+        Geom_BSplineCurve removed = refined;
+        const int nbRemovals = removed.RemoveKnots(0.0);
+        if (nbRemovals != nbKnots || removed.NbPoles() != curve.NbPoles() || Deviation(removed, curve) > tolerance)
+        {
+            std::printf("  RemoveKnots: %d removals, %d poles, deviation %g\n", nbRemovals, removed.NbPoles(), Deviation(removed, curve));
+            ++nbErrors;
+        }
+
+        // The double knot 1.5 is the knot 3 of the refined curve.
+        removed = refined;
+        const int nbKnotRemovals = removed.RemoveKnot(3, 2, 0.0);
+        if (nbKnotRemovals != 2 || removed.NbPoles() != refined.NbPoles() - 2 || Deviation(removed, curve) > tolerance)
+        {
+            std::printf("  RemoveKnot: %d removals, %d poles, deviation %g\n", nbKnotRemovals, removed.NbPoles(), Deviation(removed, curve));
+            ++nbErrors;
+        }
+        return nbErrors;
+    }
+
+    // Returns the number of failed checks of the displacement of the removals at non-zero tolerances.
+    // The largest tolerance must remove knots, so that the bound is checked on displaced curves.
+    int CheckTolerance(const Geom_BSplineCurve& curve)
+    {
+        int nbErrors = 0;
+        for (const double tolerance : {1.e-3, 1.e-2, 1.e-1})
+        {
+            Geom_BSplineCurve removed = curve;
+            const int nbRemovals = removed.RemoveKnots(tolerance);
+            if (Deviation(removed, curve) > tolerance || (tolerance == 1.e-1 && nbRemovals == 0))
+            {
+                std::printf("  RemoveKnots(%g): %d removals, deviation %g\n", tolerance, nbRemovals, Deviation(removed, curve));
+                ++nbErrors;
+            }
+
+            removed = curve;
+            const int nbKnotRemovals = removed.RemoveKnot(10, 1, tolerance);
+            if (Deviation(removed, curve) > tolerance)
+            {
+                std::printf("  RemoveKnot(%g): %d removals, deviation %g\n", tolerance, nbKnotRemovals, Deviation(removed, curve));
+                ++nbErrors;
+            }
+        }
+        return nbErrors;
+    }
+
+    // Returns 1 if the curve whose first span is empty is not finite below its first parameter.
+    int CheckEmptySpan()
+    {
+        const gp_Array1OfPnt poles = {gp_Pnt(0.0, 0.0, 0.0), gp_Pnt(1.0, 2.0, 0.0), gp_Pnt(2.0, -1.0, 1.0),
+                                      gp_Pnt(3.0, 1.0, 0.0), gp_Pnt(4.0, 0.0, 2.0)};
+        const Geom_BSplineCurve curve(poles, {0.0, 1.0, 2.0, 3.0}, {2, 3, 2, 2}, 3);
+        gp_Pnt p;
+        curve.D0(0.5, p);
+        if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z))
+        {
+            std::printf("Empty first span: D0(0.5) is not finite\n");
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main()
+{
+    int nbFailures = 0;
+    for (const int degree : {2, 3, 5})
+    {
+        for (const bool rational : {false, true})
+        {
+            std::printf("Degree %d%s\n", degree, rational ? " rational" : "");
+            const Geom_BSplineCurve curve = MakeCurve(degree, rational);
+            nbFailures += CheckInsertRemove(curve);
+            nbFailures += CheckTolerance(MakeDenseCurve(degree, rational));
+        }
+    }
+    nbFailures += CheckEmptySpan();
+    return nbFailures == 0 ? 0 : 1;
+}
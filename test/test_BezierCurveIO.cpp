@@ -0,0 +1,117 @@
+// Checks that a set of Bezier curves is read back unchanged from a curve file and from a stream file,
+// with and without the prefetch of the chunks.
+
+#include "io/io_BezierCurveFile.h"
+#include "io/io_BezierCurveReader.h"
+#include "io/io_BezierCurveWriter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace
+{
+    // Builds a set of curves of all the degrees, one rational curve out of three.
+    Geom_BezierCurveSet MakeSet(const int nbCurves)
+    {
+        Geom_BezierCurveSet set;
+        gp_Pnt poles[Geom_BezierCurve::MaxDegree() + 1];
+        double weights[Geom_BezierCurve::MaxDegree() + 1];
+        for (int i = 0; i < nbCurves; ++i)
+        {
+            const int nbPoles = 2 + i % Geom_BezierCurve::MaxDegree();
+            for (int j = 0; j < nbPoles; ++j)
+            {
+                poles[j] = gp_Pnt(i + std::cos(0.7 * j), std::sin(0.7 * j), 0.3 * j - 0.01 * i);
+                weights[j] = 1.0 + 0.25 * ((i + j) % 3);
+            }
+            set.Append(poles, nbPoles, i % 3 == 0 ? weights : nullptr);
+        }
+        return set;
+    }
+
+    // Returns the number of curves of read which differ from the ones of expected, or -1 if their numbers differ.
+    template <typename Curves>
+    int Compare(const Geom_BezierCurveSet& expected, const Curves& read)
+    {
+        if (read.NbCurves() != expected.NbCurves())
+        {
+            return -1;
+        }
+
+        int nbErrors = 0;
+        for (int i = 0; i < expected.NbCurves(); ++i)
+        {
+            const Geom_BezierCurveView a = expected.Curve(i);
+            const Geom_BezierCurveView b = read.Curve(i);
+            bool same = a.Degree() == b.Degree() && a.IsRational() == b.IsRational();
+            for (int j = 0; same && j < a.NbPoles(); ++j)
+            {
+                same = a.Pole(j) == b.Pole(j) && a.Weight(j) == b.Weight(j);
+            }
+            if (!same)
+            {
+                ++nbErrors;
+            }
+        }
+        return nbErrors;
+    }
+
+    // Returns 1 if the curves read from the curve file differ.
+    int CheckFile(const Geom_BezierCurveSet& set, const std::string& path)
+    {
+        IO_BezierCurveFile::Write(set, path);
+        const int nbErrors = Compare(set, IO_BezierCurveFile(path));
+        std::printf("Curve file: %d curves differ\n", nbErrors);
+        return nbErrors == 0 ? 0 : 1;
+    }
+
+    // Returns 1 if the curves read from the stream file, in chunks of at most chunkSize poles, differ.
+    int CheckStream(const Geom_BezierCurveSet& set, const std::string& path, const int chunkSize, const bool prefetch)
+    {
+        IO_BezierCurveWriter writer(path, chunkSize);
+        writer.Write(set);
+        writer.Close();
+
+        Geom_BezierCurveSet read;
+        int nbChunks = 0;
+        IO_BezierCurveReader reader(path, prefetch);
+        reader.ForEach([&](const Geom_BezierCurveSet& chunk)
+        {
+            for (const Geom_BezierCurveView curve : chunk)
+            {
+                read.Append(curve);
+            }
+            ++nbChunks;
+        });
+
+        const int nbErrors = Compare(set, read);
+        std::printf("Stream file, chunks of %d poles%s: %d chunks, %d curves differ\n", chunkSize,
+                    prefetch ? ", prefetch" : "", nbChunks, nbErrors);
+        return nbErrors == 0 && reader.ChunkSize() == chunkSize ? 0 : 1;
+    }
+}
+
+int main()
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string filePath = (directory / "test_BezierCurveIO.bez").string();
+    const std::string streamPath = (directory / "test_BezierCurveIO.bzs").string();
+
+    const Geom_BezierCurveSet set = MakeSet(1000);
+
+    int nbFailures = CheckFile(set, filePath);
+    nbFailures += CheckFile(Geom_BezierCurveSet(), filePath);
+    for (const bool prefetch : {false, true})
+    {
+        // A chunk of the largest curve only, and chunks of many curves.
+        nbFailures += CheckStream(set, streamPath, Geom_BezierCurve::MaxDegree() + 1, prefetch);
+        nbFailures += CheckStream(set, streamPath, 1 << 10, prefetch);
+        nbFailures += CheckStream(Geom_BezierCurveSet(), streamPath, 1 << 10, prefetch);
+    }
+
+    std::filesystem::remove(filePath);
+    std::filesystem::remove(streamPath);
+    return nbFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+// Compares the batch evaluation of Bezier curves on each instruction set with the evaluation of single points.
+
+#include "curve/geom_BezierCurve.h"
+#include "curve/geom_BezierKernel.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    const char* Name(const CPU_InstructionSet set)
+    {
+        switch (set)
+        {
+        case CPU_InstructionSet::CPU_AVX512:
+            return "AVX-512";
+        case CPU_InstructionSet::CPU_AVX2:
+            return "AVX2";
+        case CPU_InstructionSet::CPU_SSE2:
+            return "SSE2";
+        default:
+            return "Scalar";
+        }
+    }
+
+    // Builds a curve of the given degree with poles on a helix and, if rational, varying weights.
+    Geom_BezierCurve MakeCurve(const int degree, const bool rational)
+    {
+        gp_Array1OfPnt poles;
+        std_Array1OfReal weights;
+        for (int i = 0; i <= degree; ++i)
+        {
+            poles.push_back(gp_Pnt(std::cos(0.7 * i), std::sin(0.7 * i), 0.3 * i - 0.02 * i * i));
+            weights.push_back(1.0 + 0.25 * (i % 3));
+        }
+        return rational ? Geom_BezierCurve(poles, weights) : Geom_BezierCurve(poles);
+    }
+
+    double Distance(const gp_Vec& a, const gp_Vec& b)
+    {
+        return glm::length(a - b) / std::max(1.0, glm::length(b));
+    }
+
+    // Returns the number of parameters whose batch results differ from D1 and D2.
+    int Check(const Geom_BezierCurve& curve)
+    {
+        // An odd count leaves a partial block for every vector width.
+        const int nbParams = 37;
+        std::vector<double> params(nbParams);
+        for (int i = 0; i < nbParams; ++i)
+        {
+            params[i] = double(i) / (nbParams - 1);
+        }
+
+        std::vector<double> buffers[9];
+        for (std::vector<double>& buffer : buffers)
+        {
+            buffer.assign(nbParams, 0.0);
+        }
+        const gp_SoAOfXYZ p = {buffers[0].data(), buffers[1].data(), buffers[2].data()};
+        const gp_SoAOfXYZ v1 = {buffers[3].data(), buffers[4].data(), buffers[5].data()};
+        const gp_SoAOfXYZ v2 = {buffers[6].data(), buffers[7].data(), buffers[8].data()};
+        curve.D2Batch(params.data(), nbParams, p, v1, v2);
+
+        std::vector<double> points[3];
+        for (std::vector<double>& buffer : points)
+        {
+            buffer.assign(nbParams, 0.0);
+        }
+        const gp_SoAOfXYZ p0 = {points[0].data(), points[1].data(), points[2].data()};
+        curve.D0Batch(params.data(), nbParams, p0);
+
+        const double tolerance = 1.e-9;
+        int nbErrors = 0;
+        for (int i = 0; i < nbParams; ++i)
+        {
+            gp_Pnt point;
+            gp_Vec d1, d2;
+            curve.D2(params[i], point, d1, d2);
+
+            gp_Pnt point1;
+            gp_Vec d11;
+            curve.D1(params[i], point1, d11);
+
+            if (Distance(p.Value(i), point) > tolerance || Distance(p0.Value(i), point) > tolerance ||
+                Distance(v1.Value(i), d1) > tolerance || Distance(v1.Value(i), d11) > tolerance ||
+                Distance(v2.Value(i), d2) > tolerance)
+            {
+                ++nbErrors;
+            }
+        }
+        return nbErrors;
+    }
+}
+
+int main()
+{
+    const CPU_InstructionSet sets[] = {CPU_InstructionSet::CPU_Scalar, CPU_InstructionSet::CPU_SSE2,
+                                       CPU_InstructionSet::CPU_AVX2, CPU_InstructionSet::CPU_AVX512};
+
+    // Degrees up to Geom_BezierKernel::MaxMonomialDegree run the Horner kernel, higher ones the de Casteljau kernel.
+    const int degrees[] = {1, 2, 3, 5, 12, 13, 25};
+
+    int nbFailures = 0;
+    for (const CPU_InstructionSet set : sets)
+    {
+        Geom_BezierKernel::SetInstructionSet(set);
+        if (Geom_BezierKernel::InstructionSet() != set)
+        {
+            std::printf("%s: not supported, lowered to %s\n", Name(set), Name(Geom_BezierKernel::InstructionSet()));
+            continue;
+        }
+
+        for (const int degree : degrees)
+        {
+            for (const bool rational : {false, true})
+            {
+                const int nbErrors = Check(MakeCurve(degree, rational));
+                if (nbErrors != 0)
+                {
+                    std::printf("%s: degree %d%s, %d parameters differ\n", Name(set), degree, rational ? " rational" : "", nbErrors);
+                    ++nbFailures;
+                }
+            }
+        }
+        std::printf("%s: checked\n", Name(set));
+    }
+
+    Geom_BezierKernel::SetInstructionSet(CPU::Best());
+    return nbFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// Checks the hits of rays with the patches of a closed solid: the rays from the inside hit the solid once
+// on a point of the patch hit, the rays from the outside hit the nearest face and the rays away from it miss.
+
+#include "bvh/bvh_RayIntersector.h"
+
+#include <cmath>
+#include <cstdio>
+#include <glm/gtc/constants.hpp>
+#include <vector>
+
+namespace
+{
+    // Builds the six bicubic patches of a cube [-1, 1]^3 whose faces bulge outwards, the patch of the face +x first.
+    std::vector<handle<Geom_BezierSurface>> MakeSolid()
+    {
+        // Corner, u axis and v axis of each face.
+        const gp_Vec faces[6][3] = {
+            {gp_Vec(1.0, -1.0, -1.0), gp_Vec(0.0, 2.0, 0.0), gp_Vec(0.0, 0.0, 2.0)},
+            {gp_Vec(-1.0, -1.0, -1.0), gp_Vec(0.0, 0.0, 2.0), gp_Vec(0.0, 2.0, 0.0)},
+            {gp_Vec(-1.0, 1.0, -1.0), gp_Vec(0.0, 0.0, 2.0), gp_Vec(2.0, 0.0, 0.0)},
+            {gp_Vec(-1.0, -1.0, -1.0), gp_Vec(2.0, 0.0, 0.0), gp_Vec(0.0, 0.0, 2.0)},
+            {gp_Vec(-1.0, -1.0, 1.0), gp_Vec(2.0, 0.0, 0.0), gp_Vec(0.0, 2.0, 0.0)},
+            {gp_Vec(-1.0, -1.0, -1.0), gp_Vec(0.0, 2.0, 0.0), gp_Vec(2.0, 0.0, 0.0)}};
+
+        std::vector<handle<Geom_BezierSurface>> patches;
+        for (const auto& face : faces)
+        {
+            const gp_Vec normal = 0.5 * glm::normalize(glm::cross(face[1], face[2]));
+            gp_Array1OfPnt poles;
+            for (int i = 0; i < 4; ++i)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    const bool interior = i > 0 && i < 3 && j > 0 && j < 3;
+                    poles.push_back(face[0] + (i / 3.0) * face[1] + (j / 3.0) * face[2] + (interior ? normal : gp_Vec(0.0)));
+                }
+            }
+            patches.push_back(std::make_shared<Geom_BezierSurface>(poles, 4, 4));
+        }
+        return patches;
+    }
+
+    // Rays of origins and directions in rows of coordinates.
+    struct Rays
+    {
+        std::vector<double> rows[6];
+
+        void Add(const gp_Pnt& origin, const gp_Vec& direction)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                rows[c].push_back(origin[c]);
+                rows[3 + c].push_back(direction[c]);
+            }
+        }
+
+        gp_SoAOfXYZ Origins()
+        {
+            return {rows[0].data(), rows[1].data(), rows[2].data()};
+        }
+
+        gp_SoAOfXYZ Directions()
+        {
+            return {rows[3].data(), rows[4].data(), rows[5].data()};
+        }
+
+        int NbRays() const
+        {
+            return static_cast<int>(rows[0].size());
+        }
+    };
+
+    // Returns true if the point of the hit on its patch is the point of the ray.
+    bool IsOnRay(const BVH_PatchTree& tree, const BVH_RayHit& hit, const gp_Pnt& origin, const gp_Vec& direction)
+    {
+        const gp_Pnt point = tree.Patch(hit.patch).Value(hit.u, hit.v);
+        return hit.t >= 0.0 && glm::distance(point, origin + hit.t * direction) < 1.e-6;
+    }
+}
+
+int main()
+{
+    const std::vector<handle<Geom_BezierSurface>> patches = MakeSolid();
+    const BVH_PatchTree tree(patches.data(), static_cast<int>(patches.size()));
+    const BVH_RayIntersector intersector(tree);
+
+    // Rays from the center in all the directions, an odd number to leave a partial packet.
+    Rays inside;
+    const int nbTheta = 15, nbPhi = 31;
+    for (int i = 0; i < nbTheta; ++i)
+    {
+        const double theta = glm::pi<double>() * (i + 0.5) / nbTheta;
+        for (int j = 0; j < nbPhi; ++j)
+        {
+            const double phi = 2.0 * glm::pi<double>() * j / nbPhi;
+            inside.Add(gp_Pnt(0.1, -0.05, 0.02), gp_Vec(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)));
+        }
+    }
+
+    // Rays from the outside along -x through the face +x, then along +x away from the solid.
+    Rays outside;
+    for (int i = 0; i < 9; ++i)
+    {
+        const gp_Pnt origin(5.0, -0.8 + 0.2 * i, 0.7 - 0.15 * i);
+        outside.Add(origin, gp_Vec(-1.0, 0.0, 0.0));
+        outside.Add(origin, gp_Vec(1.0, 0.0, 0.0));
+    }
+
+    int nbFailures = 0;
+    std::vector<BVH_RayHit> hits(inside.NbRays());
+    intersector.Perform(inside.Origins(), inside.Directions(), inside.NbRays(), hits.data());
+    int nbErrors = 0;
+    for (int i = 0; i < inside.NbRays(); ++i)
+    {
+        if (hits[i].patch < 0 || !IsOnRay(tree, hits[i], inside.Origins().Value(i), inside.Directions().Value(i)))
+        {
+            ++nbErrors;
+        }
+    }
+    std::printf("Rays from the inside: %d of %d rays wrong\n", nbErrors, inside.NbRays());
+    nbFailures += nbErrors == 0 ? 0 : 1;
+
+    hits.resize(outside.NbRays());
+    intersector.Perform(outside.Origins(), outside.Directions(), outside.NbRays(), hits.data());
+    nbErrors = 0;
+    for (int i = 0; i < outside.NbRays(); i += 2)
+    {
+        if (hits[i].patch != 0 || !IsOnRay(tree, hits[i], outside.Origins().Value(i), outside.Directions().Value(i)) ||
+            hits[i + 1].patch != -1)
+        {
+            ++nbErrors;
+        }
+    }
+    std::printf("Rays from the outside: %d of %d rays wrong\n", nbErrors, outside.NbRays() / 2);
+    nbFailures += nbErrors == 0 ? 0 : 1;
+
+    return nbFailures == 0 ? 0 : 1;
+}
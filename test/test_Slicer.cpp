@@ -0,0 +1,113 @@
+// Checks the layers of a closed solid sliced by horizontal planes: each layer is one closed counterclockwise
+// contour on its plane, and the crossings of a curve with the planes are on the plane and on the curve.
+
+#include "slice/slice_Slicer.h"
+#include "surface/geom_BezierSurface.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    // Builds the six bicubic patches of a cube [-1, 1]^3 whose faces bulge outwards, each one oriented outwards.
+    std::vector<handle<Geom_Surface>> MakeSolid()
+    {
+        // Corner, u axis and v axis of each face.
+        const gp_Vec faces[6][3] = {
+            {gp_Vec(1.0, -1.0, -1.0), gp_Vec(0.0, 2.0, 0.0), gp_Vec(0.0, 0.0, 2.0)},
+            {gp_Vec(-1.0, -1.0, -1.0), gp_Vec(0.0, 0.0, 2.0), gp_Vec(0.0, 2.0, 0.0)},
+            {gp_Vec(-1.0, 1.0, -1.0), gp_Vec(0.0, 0.0, 2.0), gp_Vec(2.0, 0.0, 0.0)},
+            {gp_Vec(-1.0, -1.0, -1.0), gp_Vec(2.0, 0.0, 0.0), gp_Vec(0.0, 0.0, 2.0)},
+            {gp_Vec(-1.0, -1.0, 1.0), gp_Vec(2.0, 0.0, 0.0), gp_Vec(0.0, 2.0, 0.0)},
+            {gp_Vec(-1.0, -1.0, -1.0), gp_Vec(0.0, 2.0, 0.0), gp_Vec(2.0, 0.0, 0.0)}};
+
+        std::vector<handle<Geom_Surface>> patches;
+        for (const auto& face : faces)
+        {
+            const gp_Vec normal = 0.5 * glm::normalize(glm::cross(face[1], face[2]));
+            gp_Array1OfPnt poles;
+            for (int i = 0; i < 4; ++i)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    const bool interior = i > 0 && i < 3 && j > 0 && j < 3;
+                    poles.push_back(face[0] + (i / 3.0) * face[1] + (j / 3.0) * face[2] + (interior ? normal : gp_Vec(0.0)));
+                }
+            }
+            patches.push_back(std::make_shared<Geom_BezierSurface>(poles, 4, 4));
+        }
+        return patches;
+    }
+
+    // Returns true if the layer is one closed contour on its plane, counterclockwise around +z.
+    bool CheckContour(const Slice_Layer& layer)
+    {
+        if (layer.NbContours() != 1)
+        {
+            return false;
+        }
+
+        const int first = layer.contours[0], last = layer.contours[1] - 1;
+        if (last - first < 3 || layer.points[first] != layer.points[last])
+        {
+            return false;
+        }
+
+        double area = 0.0;
+        for (int i = first; i < last; ++i)
+        {
+            const gp_Pnt& p = layer.points[i];
+            const gp_Pnt& q = layer.points[i + 1];
+            if (std::abs(p.z - layer.height) > 1.e-12)
+            {
+                return false;
+            }
+            area += p.x * q.y - q.x * p.y;
+        }
+        return area > 0.0;
+    }
+}
+
+int main()
+{
+    const Slice_Slicer slicer = Slice_Slicer::Uniform(gp_Vec(0.0, 0.0, 1.0), -0.95, 0.1, 20);
+    const std::vector<handle<Geom_Surface>> patches = MakeSolid();
+    std::vector<Slice_Layer> layers = slicer.SlicePatches(patches.data(), static_cast<int>(patches.size()), 1.e-2, 0.3);
+
+    int nbFailures = 0;
+    int nbErrors = 0;
+    for (const Slice_Layer& layer : layers)
+    {
+        if (!CheckContour(layer))
+        {
+            std::printf("Layer %g: %d contours\n", layer.height, layer.NbContours());
+            ++nbErrors;
+        }
+    }
+    std::printf("Solid: %d of %d layers wrong\n", nbErrors, static_cast<int>(layers.size()));
+    nbFailures += nbErrors == 0 ? 0 : 1;
+
+    // A helix of increasing height crosses each plane once.
+    gp_Array1OfPnt poles;
+    for (int i = 0; i <= 7; ++i)
+    {
+        poles.push_back(gp_Pnt(std::cos(0.9 * i), std::sin(0.9 * i), -1.2 + 0.35 * i));
+    }
+    const handle<Geom_BezierCurve> curve = std::make_shared<Geom_BezierCurve>(poles);
+    slicer.SliceCurves(&curve, 1, layers);
+
+    nbErrors = 0;
+    for (const Slice_Layer& layer : layers)
+    {
+        if (layer.crossings.size() != 1 || layer.crossingCurves[0] != 0 || std::abs(layer.crossings[0].z - layer.height) > 1.e-9 ||
+            glm::distance(curve->Value(layer.crossingParameters[0]), layer.crossings[0]) > 1.e-9)
+        {
+            ++nbErrors;
+        }
+    }
+    std::printf("Curve: %d of %d layers wrong\n", nbErrors, static_cast<int>(layers.size()));
+    nbFailures += nbErrors == 0 ? 0 : 1;
+
+    return nbFailures == 0 ? 0 : 1;
+}
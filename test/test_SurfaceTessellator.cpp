@@ -0,0 +1,101 @@
+// Checks that the tessellation of a closed solid of several patches is watertight and consistently oriented.
+
+#include "mesh/mesh_SurfaceTessellator.h"
+#include "surface/geom_BezierSurface.h"
+
+#include <cstdio>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Builds the six bicubic patches of a cube [-1, 1]^3 whose faces bulge outwards: the boundary poles are on
+    // the edges of the cube, shared by the neighbouring patches, and the interior poles are moved along the normal.
+    // Each patch is parameterized so that its normal points outwards.
+    std::vector<handle<Geom_Surface>> MakeSolid(const bool rational)
+    {
+        // Corner, u axis and v axis of each face.
+        const gp_Vec faces[6][3] = {
+            {gp_Vec(1.0, -1.0, -1.0), gp_Vec(0.0, 2.0, 0.0), gp_Vec(0.0, 0.0, 2.0)},
+            {gp_Vec(-1.0, -1.0, -1.0), gp_Vec(0.0, 0.0, 2.0), gp_Vec(0.0, 2.0, 0.0)},
+            {gp_Vec(-1.0, 1.0, -1.0), gp_Vec(0.0, 0.0, 2.0), gp_Vec(2.0, 0.0, 0.0)},
+            {gp_Vec(-1.0, -1.0, -1.0), gp_Vec(2.0, 0.0, 0.0), gp_Vec(0.0, 0.0, 2.0)},
+            {gp_Vec(-1.0, -1.0, 1.0), gp_Vec(2.0, 0.0, 0.0), gp_Vec(0.0, 2.0, 0.0)},
+            {gp_Vec(-1.0, -1.0, -1.0), gp_Vec(0.0, 2.0, 0.0), gp_Vec(2.0, 0.0, 0.0)}};
+
+        std::vector<handle<Geom_Surface>> patches;
+        for (const auto& face : faces)
+        {
+            const gp_Vec normal = 0.5 * glm::normalize(glm::cross(face[1], face[2]));
+            gp_Array1OfPnt poles;
+            std_Array1OfReal weights;
+            for (int i = 0; i < 4; ++i)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    const bool interior = i > 0 && i < 3 && j > 0 && j < 3;
+                    poles.push_back(face[0] + (i / 3.0) * face[1] + (j / 3.0) * face[2] + (interior ? normal : gp_Vec(0.0)));
+                    weights.push_back(interior ? 2.0 : 1.0);
+                }
+            }
+            if (rational)
+            {
+                patches.push_back(std::make_shared<Geom_BezierSurface>(poles, weights, 4, 4));
+            }
+            else
+            {
+                patches.push_back(std::make_shared<Geom_BezierSurface>(poles, 4, 4));
+            }
+        }
+        return patches;
+    }
+
+    // Returns the number of edges of the triangulation not shared by exactly two triangles, in opposite directions.
+    int CheckEdges(const Mesh_Triangulation& mesh)
+    {
+        // Number of uses of each directed edge.
+        std::map<std::pair<int, int>, int> edges;
+        for (const Mesh_Triangle& triangle : mesh.triangles)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                ++edges[std::make_pair(triangle[k], triangle[(k + 1) % 3])];
+            }
+        }
+
+        int nbErrors = 0;
+        for (const auto& edge : edges)
+        {
+            const auto opposite = edges.find(std::make_pair(edge.first.second, edge.first.first));
+            if (edge.second != 1 || opposite == edges.end() || opposite->second != 1)
+            {
+                ++nbErrors;
+            }
+        }
+        return nbErrors;
+    }
+}
+
+int main()
+{
+    const Mesh_SurfaceTessellator tessellator(1.e-2, 0.3);
+
+    int nbFailures = 0;
+    for (const bool rational : {false, true})
+    {
+        const std::vector<handle<Geom_Surface>> patches = MakeSolid(rational);
+        const Mesh_Triangulation mesh = tessellator.Perform(patches.data(), static_cast<int>(patches.size()));
+
+        // A closed triangulation of genus 0: V - E + F = 2, with 3 F = 2 E.
+        const int nbErrors = CheckEdges(mesh);
+        const int euler = mesh.NbNodes() - mesh.NbTriangles() / 2;
+        std::printf("%s solid: %d nodes, %d triangles, %d bad edges, Euler characteristic %d\n",
+                    rational ? "Rational" : "Polynomial", mesh.NbNodes(), mesh.NbTriangles(), nbErrors, euler);
+        if (nbErrors != 0 || euler != 2)
+        {
+            ++nbFailures;
+        }
+    }
+    return nbFailures == 0 ? 0 : 1;
+}